@@ -6,4 +6,8 @@ pushd fuzzing
 cmake -DBOLOS_SDK=../BOLOS_SDK -Bbuild -H.
 make -C build
 mv ./build/fuzz "${OUT}"
-popd
\ No newline at end of file
+
+# seed corpus, including transactions with tampered offsets
+python3 generate_seeds.py ./build/seeds
+zip -j "${OUT}/fuzz_seed_corpus.zip" ./build/seeds/*
+popd
@@ -0,0 +1,246 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "plugin.h"
+#include "host_plugin.h"
+// CALLDATA, the transactions of the functional tests generated by generate_bench_calldata.py
+#include "bench_calldata.h"
+
+// Microbenchmark of the plugin callbacks on the host, run with `./build/bench [iterations]`.
+// Every selector replays a fixed transaction through the whole plugin flow and the time (and
+// retired instructions when perf counters are available) spent in each callback is reported as
+// JSON on stdout.
+
+#define DEFAULT_ITERATIONS 10000
+#define MAX_CALLDATA_SIZE  2048
+// Ethereum mainnet, whose registry holds the strategies of the calldata
+#define MAINNET_CHAIN_ID 1
+
+#define TO_NAME(name, selector, label, screens, finalize, handler) #name,
+static const char *const SELECTOR_NAMES[SELECTOR_COUNT] = {SELECTORS_LIST(TO_NAME)};
+
+// Callbacks of the plugin, as the host API names them
+#define FIRST_CALLBACK HOST_INIT_CONTRACT
+#define CALLBACK_COUNT (HOST_QUERY_CONTRACT_UI + 1)
+
+typedef struct {
+    uint64_t calls;
+    uint64_t ns;
+    uint64_t instructions;
+} measure_t;
+
+static int perf_fd = -1;
+
+/**
+ * @brief Open a counter of the instructions retired in user space by this thread, counting
+ * starts right away
+ *
+ * @returns false if perf counters are not available
+ */
+static bool perf_open(void) {
+#ifdef __linux__
+    struct perf_event_attr attr = {0};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    perf_fd = (int) syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    return perf_fd >= 0;
+}
+
+static uint64_t perf_read(void) {
+    uint64_t count = 0;
+#ifdef __linux__
+    if (perf_fd >= 0 && read(perf_fd, &count, sizeof(count)) != sizeof(count)) {
+        count = 0;
+    }
+#endif
+    return count;
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+typedef struct {
+    uint64_t ns;
+    uint64_t instructions;
+} sample_t;
+
+static void start(sample_t *sample) {
+    sample->instructions = perf_read();
+    sample->ns = now_ns();
+}
+
+static void stop(const sample_t *sample, measure_t *measure, uint64_t calls) {
+    uint64_t ns = now_ns();
+    uint64_t instructions = perf_read();
+    measure->calls += calls;
+    measure->ns += ns - sample->ns;
+    measure->instructions += instructions - sample->instructions;
+}
+
+// Timer of the callbacks of a run, switched by the hook of host_plugin_resume
+typedef struct {
+    measure_t *measures;
+    host_status_t callback;  // callback being timed, HOST_OK if none
+    uint64_t calls;          // consecutive calls of `callback`
+    sample_t sample;
+} callback_timer_t;
+
+/**
+ * @brief Hook of host_plugin_resume: consecutive calls of a callback are timed together, so that
+ * the timer is not read around every parameter
+ */
+static void time_callback(host_status_t callback,
+                          const uint8_t *context,
+                          size_t position,
+                          void *arg) {
+    callback_timer_t *timer = arg;
+
+    (void) context;
+    (void) position;
+    if (callback == timer->callback) {
+        timer->calls++;
+        return;
+    }
+    if (timer->callback != HOST_OK) {
+        stop(&timer->sample, &timer->measures[timer->callback], timer->calls);
+    }
+    timer->callback = callback;
+    timer->calls = 1;
+    start(&timer->sample);
+}
+
+/**
+ * @brief Replay one transaction through every callback of the plugin
+ *
+ * @param calldata: selector followed by the parameters
+ * @param size: calldata size
+ * @param screens: screens of the transaction, HOST_MAX_SCREENS long
+ * @param measures: time spent per callback, updated
+ *
+ * @returns number of screens displayed, 0 if the transaction was rejected
+ */
+static int run(const uint8_t *calldata,
+               size_t size,
+               host_screen_t *screens,
+               measure_t measures[CALLBACK_COUNT]) {
+    context_t context;
+    callback_timer_t timer = {.measures = measures, .callback = HOST_OK};
+    size_t count;
+    size_t position;
+    sample_t sample;
+    host_status_t status;
+
+    start(&sample);
+    status = host_plugin_init(calldata, size, MAINNET_CHAIN_ID, (uint8_t *) &context);
+    stop(&sample, &measures[HOST_INIT_CONTRACT], 1);
+    if (status != HOST_OK) {
+        return 0;
+    }
+    status = host_plugin_resume(calldata,
+                                size,
+                                MAINNET_CHAIN_ID,
+                                (uint8_t *) &context,
+                                SELECTOR_SIZE,
+                                time_callback,
+                                &timer,
+                                screens,
+                                &count,
+                                &position);
+    // the ID screen is not displayed by handle_query_contract_ui
+    return (status == HOST_OK) ? (int) count - 1 : 0;
+}
+
+static void print_measure(const measure_t *measure, bool perf) {
+    printf("{\"calls\": %llu, \"ns_per_op\": %.1f",
+           (unsigned long long) measure->calls,
+           measure->calls ? (double) measure->ns / measure->calls : 0.0);
+    if (perf) {
+        printf(", \"instructions_per_op\": %.1f",
+               measure->calls ? (double) measure->instructions / measure->calls : 0.0);
+    }
+    printf("}");
+}
+
+int main(int argc, char **argv) {
+    static uint8_t calldata[MAX_CALLDATA_SIZE];
+    unsigned long iterations = (argc > 1) ? strtoul(argv[1], NULL, 10) : DEFAULT_ITERATIONS;
+    int status = EXIT_SUCCESS;
+
+    if (iterations == 0) {
+        fprintf(stderr, "Usage: %s [iterations]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    // nothing is printed before the allocation succeeds, stdout is either valid JSON or empty
+    host_screen_t *screens = malloc(HOST_MAX_SCREENS * sizeof(host_screen_t));
+    if (screens == NULL) {
+        perror("malloc");
+        return EXIT_FAILURE;
+    }
+    bool perf = perf_open();
+    printf("{\"iterations\": %lu, \"perf\": %s, \"selectors\": [\n",
+           iterations,
+           perf ? "true" : "false");
+    for (int selector = 0; selector < SELECTOR_COUNT; selector++) {
+        measure_t measures[CALLBACK_COUNT] = {0};
+        measure_t total = {0};
+        size_t length = strlen(CALLDATA[selector]);
+        size_t size = 0;
+        int displayed = 0;
+
+        if (length / 2 > sizeof(calldata) ||
+            !host_decode_hex(CALLDATA[selector], length, calldata, &size)) {
+            fprintf(stderr, "%s: invalid calldata\n", SELECTOR_NAMES[selector]);
+            return EXIT_FAILURE;
+        }
+
+        for (unsigned long i = 0; i < iterations; i++) {
+            displayed = run(calldata, size, screens, measures);
+            if (displayed == 0) {
+                fprintf(stderr, "%s: transaction rejected\n", SELECTOR_NAMES[selector]);
+                status = EXIT_FAILURE;
+                break;
+            }
+        }
+        for (int callback = FIRST_CALLBACK; callback < CALLBACK_COUNT; callback++) {
+            total.ns += measures[callback].ns;
+            total.instructions += measures[callback].instructions;
+        }
+        // one operation is a whole transaction
+        total.calls = measures[HOST_INIT_CONTRACT].calls;
+
+        printf("  {\"name\": \"%s\", \"selector\": \"0x%08x\", \"parameters\": %zu, "
+               "\"screens\": %d,\n",
+               SELECTOR_NAMES[selector],
+               SELECTORS[selector],
+               (size - SELECTOR_SIZE) / PARAMETER_LENGTH,
+               displayed);
+        printf("   \"transaction\": ");
+        print_measure(&total, perf);
+        printf(",\n   \"callbacks\": {\n");
+        for (int callback = FIRST_CALLBACK; callback < CALLBACK_COUNT; callback++) {
+            printf("     \"%s\": ", host_status_name(callback));
+            print_measure(&measures[callback], perf);
+            printf("%s\n", callback + 1 < CALLBACK_COUNT ? "," : "");
+        }
+        printf("   }}%s\n", selector + 1 < SELECTOR_COUNT ? "," : "");
+    }
+    printf("]}\n");
+
+    free(screens);
+    return status;
+}
@@ -0,0 +1,458 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "plugin.h"
+
+// Structure-aware mutator of the fuzzer.
+//
+// Random bytes almost never get past the offsets verification and the registry lookups, so the
+// inputs are mutated as ABI encoded calls instead: whole transactions are generated from the parser
+// tables, with consistent array lengths and the strategies and tokens of the registry, and the
+// existing inputs are mutated one 32-byte parameter at a time.
+
+size_t LLVMFuzzerMutate(uint8_t *data, size_t size, size_t max_size);
+
+#define SELECTOR_LENGTH 4
+#define WORD_LENGTH     32
+// Token lookups appended to the calldata, see `fuzz_plugin.c`
+#define LOOKUPS_LENGTH (sizeof(extraInfo_t) * 2)
+
+// Chain of the registry, see `fuzz_plugin.c`
+#define FUZZ_CHAIN_ID 1
+
+// Bounds of the generated transactions, enough for runs of strategies, share totals and
+// withdrawals dropped from the strategies list
+#define GEN_MAX_WITHDRAWALS 4
+#define GEN_MAX_STRATEGIES  8
+
+typedef enum {
+    MUTATE_SELECTOR = 0,
+    MUTATE_STRATEGY,
+    MUTATE_TOKEN,
+    MUTATE_COUNT,
+    MUTATE_OFFSET,
+    MUTATE_AMOUNT,
+    MUTATE_SWAP,
+    MUTATE_DUPLICATE,
+    MUTATE_DELETE,
+    MUTATE_BYTES,
+    MUTATIONS_COUNT,
+} mutation_t;
+
+typedef struct {
+    uint32_t state;  // xorshift32
+    const registry_t *registry;
+    uint8_t *out;
+    size_t capacity;
+    uint8_t withdrawals;                      // length of the outer arrays
+    uint8_t strategies[GEN_MAX_WITHDRAWALS];  // length of the inner arrays of each withdrawal
+    // registry index of each strategy, UNKNOWN_STRATEGY for an address out of the registry
+    uint8_t picked[GEN_MAX_WITHDRAWALS][GEN_MAX_STRATEGIES];
+    uint8_t withdrawer[ADDRESS_LENGTH];  // the same for all the withdrawals, as the plugin expects
+    uint8_t level;     // number of arrays around the node being generated
+    uint8_t element;   // index in the outer array
+    uint8_t position;  // index in the inner array
+} mutator_t;
+
+static uint32_t next_random(mutator_t *m) {
+    m->state ^= m->state << 13;
+    m->state ^= m->state >> 17;
+    m->state ^= m->state << 5;
+    return m->state;
+}
+
+static const registry_t *fuzz_registry(void) {
+    for (uint8_t i = 0; i < REGISTRIES_COUNT; i++) {
+        if (REGISTRIES[i].chain_id == FUZZ_CHAIN_ID) {
+            return &REGISTRIES[i];
+        }
+    }
+    return &REGISTRIES[REGISTRIES_COUNT];
+}
+
+/**
+ * @brief Write an address in a parameter, left padded with zeros.
+ *
+ * @param[out] word: parameter to write
+ * @param[in] address: address to write, a random one when NULL
+ */
+static void write_address(mutator_t *m, uint8_t *word, const uint8_t *address) {
+    memset(word, 0, WORD_LENGTH - ADDRESS_LENGTH);
+    for (uint8_t i = 0; i < ADDRESS_LENGTH; i++) {
+        word[WORD_LENGTH - ADDRESS_LENGTH + i] = address ? address[i] : (uint8_t) next_random(m);
+    }
+}
+
+static void write_u32_be(uint8_t *buffer, uint32_t value) {
+    buffer[0] = value >> 24;
+    buffer[1] = value >> 16;
+    buffer[2] = value >> 8;
+    buffer[3] = value;
+}
+
+static void write_number(uint8_t *word, uint32_t value) {
+    memset(word, 0, WORD_LENGTH);
+    write_u32_be(word + WORD_LENGTH - 4, value);
+}
+
+/**
+ * @brief Write an amount, a random number small enough to be summed with the other shares of its
+ * strategy, or an edge value.
+ *
+ * @param[out] word: parameter to write
+ * @param[in] edges: whether edge values can be written
+ */
+static void write_amount(mutator_t *m, uint8_t *word, bool edges) {
+    uint32_t choice = edges ? next_random(m) % 8 : 2;
+
+    memset(word, 0, WORD_LENGTH);
+    if (choice == 0) {
+        memset(word, 0xFF, WORD_LENGTH);
+    } else if (choice == 1) {
+        word[0] = 0x80;
+    } else {
+        // below 2^248, the 256-bit totals of up to 255 shares do not overflow
+        uint8_t length = 1 + next_random(m) % (WORD_LENGTH - 1);
+        for (uint8_t i = WORD_LENGTH - length; i < WORD_LENGTH; i++) {
+            word[i] = (uint8_t) next_random(m);
+        }
+    }
+}
+
+static const uint8_t *strategy_address(const mutator_t *m, uint8_t strategy) {
+    if (strategy >= m->registry->count) {
+        return NULL;
+    }
+    return m->registry->strategy_addresses[strategy];
+}
+
+static const uint8_t *token_address(const mutator_t *m, uint8_t strategy) {
+    for (uint8_t i = 0; i < m->registry->count; i++) {
+        if (m->registry->token_strategies[i] == strategy) {
+            return m->registry->token_addresses[i];
+        }
+    }
+    return NULL;
+}
+
+static uint8_t random_strategy(mutator_t *m) {
+    if (m->registry->count == 0 || next_random(m) % 8 == 0) {
+        return UNKNOWN_STRATEGY;
+    }
+    return next_random(m) % m->registry->count;
+}
+
+/**
+ * @brief Pick the shape of the transaction to generate, its strategies and its withdrawer.
+ *
+ * Repeated strategies are frequent so that the runs of the strategies list are exercised.
+ */
+static void plan(mutator_t *m) {
+    for (uint8_t i = 0; i < ADDRESS_LENGTH; i++) {
+        m->withdrawer[i] = (uint8_t) next_random(m);
+    }
+    m->withdrawals = 1 + next_random(m) % GEN_MAX_WITHDRAWALS;
+    for (uint8_t i = 0; i < GEN_MAX_WITHDRAWALS; i++) {
+        m->strategies[i] = next_random(m) % (GEN_MAX_STRATEGIES + 1);
+        for (uint8_t j = 0; j < GEN_MAX_STRATEGIES; j++) {
+            if ((i > 0 || j > 0) && next_random(m) % 4 == 0) {
+                m->picked[i][j] = j > 0 ? m->picked[i][j - 1] : m->picked[i - 1][0];
+            } else {
+                m->picked[i][j] = random_strategy(m);
+            }
+        }
+    }
+    m->level = 0;
+    m->element = 0;
+    m->position = 0;
+}
+
+static uint16_t static_words(uint8_t index);
+
+/**
+ * @brief Number of parameters in the head of a tuple.
+ */
+static uint16_t head_words(const abi_node_t *tuple) {
+    uint16_t words = 0;
+
+    for (uint8_t i = tuple->child; i != PARSER_NO_NODE; i = PARSER_NODES[i].next) {
+        const abi_node_t *field = &PARSER_NODES[i];
+        words = field->head + ((field->flags & ABI_DYNAMIC) ? 1 : static_words(i));
+    }
+    return words;
+}
+
+/**
+ * @brief Number of parameters of a static node.
+ */
+static uint16_t static_words(uint8_t index) {
+    const abi_node_t *node = &PARSER_NODES[index];
+
+    return node->kind == ABI_TUPLE ? head_words(node) : 1;
+}
+
+static bool fits(const mutator_t *m, size_t at, size_t words) {
+    return at + words * WORD_LENGTH <= m->capacity;
+}
+
+static bool encode(mutator_t *m, uint8_t index, size_t at, size_t *end);
+
+static bool encode_word(mutator_t *m, const abi_node_t *node, size_t at, size_t *end) {
+    uint8_t *word = m->out + at;
+    uint8_t strategy = m->picked[m->element][m->position];
+
+    if (!fits(m, at, 1)) {
+        return false;
+    }
+    switch (node->field) {
+        case STRATEGY:
+            write_address(m, word, strategy_address(m, strategy));
+            break;
+        case TOKEN:
+            write_address(m, word, token_address(m, strategy));
+            break;
+        case WITHDRAWER:
+            write_address(m, word, m->withdrawer);
+            break;
+        case STAKER:
+        case OPERATOR:
+            write_address(m, word, NULL);
+            break;
+        case AMOUNT:
+            write_amount(m, word, true);
+            break;
+        case SHARE:
+            write_amount(m, word, false);
+            break;
+        default:
+            write_number(word, next_random(m));
+            break;
+    }
+    *end = at + WORD_LENGTH;
+    return true;
+}
+
+static bool encode_tuple(mutator_t *m, const abi_node_t *node, size_t at, size_t *end) {
+    size_t tail = at + head_words(node) * WORD_LENGTH;
+
+    if (tail > m->capacity) {
+        return false;
+    }
+    for (uint8_t i = node->child; i != PARSER_NO_NODE; i = PARSER_NODES[i].next) {
+        const abi_node_t *field = &PARSER_NODES[i];
+        size_t head = at + field->head * WORD_LENGTH;
+        size_t field_end;
+
+        if (field->flags & ABI_DYNAMIC) {
+            write_number(m->out + head, tail - at);
+            if (!encode(m, i, tail, &tail)) {
+                return false;
+            }
+        } else if (!encode(m, i, head, &field_end)) {
+            return false;
+        }
+    }
+    *end = tail;
+    return true;
+}
+
+/**
+ * @brief Encode an array, the outer arrays all have one element per withdrawal and the inner
+ * arrays one element per strategy of their withdrawal, as the plugin expects.
+ */
+static bool encode_array(mutator_t *m, const abi_node_t *node, size_t at, size_t *end) {
+    const abi_node_t *element = &PARSER_NODES[node->child];
+    bool dynamic = element->flags & ABI_DYNAMIC;
+    uint16_t words = dynamic ? 1 : static_words(node->child);
+    uint8_t count;
+    size_t base = at + WORD_LENGTH;
+    size_t tail;
+
+    if (m->level == 0) {
+        count = m->withdrawals;
+    } else if (m->level == 1) {
+        count = m->strategies[m->element];
+    } else {
+        count = next_random(m) % 3;
+    }
+    tail = base + (size_t) count * words * WORD_LENGTH;
+    if (tail > m->capacity) {
+        return false;
+    }
+    write_number(m->out + at, count);
+
+    m->level++;
+    for (uint8_t i = 0; i < count; i++) {
+        size_t head = base + (size_t) i * words * WORD_LENGTH;
+        size_t element_end;
+
+        if (m->level == 1) {
+            m->element = i;
+        } else if (m->level == 2) {
+            m->position = i;
+        }
+        if (dynamic) {
+            write_number(m->out + head, tail - base);
+            if (!encode(m, node->child, tail, &tail)) {
+                return false;
+            }
+        } else if (!encode(m, node->child, head, &element_end)) {
+            return false;
+        }
+    }
+    m->level--;
+    if (m->level == 0) {
+        m->element = 0;
+    }
+    m->position = 0;
+
+    *end = tail;
+    return true;
+}
+
+static bool encode_bytes(mutator_t *m, size_t at, size_t *end) {
+    uint8_t length = next_random(m) % 100;
+    size_t words = (length + WORD_LENGTH - 1) / WORD_LENGTH;
+
+    if (!fits(m, at, 1 + words)) {
+        return false;
+    }
+    write_number(m->out + at, length);
+    memset(m->out + at + WORD_LENGTH, 0, words * WORD_LENGTH);
+    for (uint8_t i = 0; i < length; i++) {
+        m->out[at + WORD_LENGTH + i] = (uint8_t) next_random(m);
+    }
+    *end = at + (1 + words) * WORD_LENGTH;
+    return true;
+}
+
+/**
+ * @brief Encode a node of the parser tables at a given offset.
+ *
+ * @param[in] index: node to encode, in PARSER_NODES
+ * @param[in] at: offset of the node in the output
+ * @param[out] end: offset of the end of the node
+ * @returns false if the output is too small
+ */
+static bool encode(mutator_t *m, uint8_t index, size_t at, size_t *end) {
+    const abi_node_t *node = &PARSER_NODES[index];
+
+    switch (node->kind) {
+        case ABI_WORD:
+            return encode_word(m, node, at, end);
+        case ABI_TUPLE:
+            return encode_tuple(m, node, at, end);
+        case ABI_ARRAY:
+            return encode_array(m, node, at, end);
+        default:
+            return encode_bytes(m, at, end);
+    }
+}
+
+/**
+ * @brief Generate a valid call of a random selector.
+ *
+ * @returns length of the calldata, 0 if it does not fit in the output
+ */
+static size_t generate(mutator_t *m) {
+    uint8_t selector = next_random(m) % SELECTOR_COUNT;
+    size_t end;
+
+    if (m->capacity < SELECTOR_LENGTH) {
+        return 0;
+    }
+    plan(m);
+    write_u32_be(m->out, SELECTORS[selector]);
+    // the parameters of the function are not preceded by their offset
+    if (!encode_tuple(m, &PARSER_NODES[PARSER_ROOTS[selector]], SELECTOR_LENGTH, &end)) {
+        return 0;
+    }
+    return end;
+}
+
+/**
+ * @brief Mutate a single parameter, or insert or delete one.
+ *
+ * @param[in] length: length of the calldata
+ * @returns new length of the calldata
+ */
+static size_t mutate_word(mutator_t *m, size_t length) {
+    size_t words = (length - SELECTOR_LENGTH) / WORD_LENGTH;
+    mutation_t mutation = words == 0 ? MUTATE_BYTES : next_random(m) % MUTATIONS_COUNT;
+    uint8_t *word = m->out + SELECTOR_LENGTH + (words ? next_random(m) % words : 0) * WORD_LENGTH;
+    uint8_t *other = m->out + SELECTOR_LENGTH + (words ? next_random(m) % words : 0) * WORD_LENGTH;
+    uint8_t swapped[WORD_LENGTH];
+    size_t at = word - m->out;
+
+    switch (mutation) {
+        case MUTATE_SELECTOR:
+            write_u32_be(m->out, SELECTORS[next_random(m) % SELECTOR_COUNT]);
+            break;
+        case MUTATE_STRATEGY:
+            write_address(m, word, strategy_address(m, random_strategy(m)));
+            break;
+        case MUTATE_TOKEN:
+            write_address(m, word, token_address(m, random_strategy(m)));
+            break;
+        case MUTATE_COUNT:
+            write_number(word, next_random(m) % (GEN_MAX_STRATEGIES + 2));
+            break;
+        case MUTATE_OFFSET:
+            write_number(word, (next_random(m) % (words + 1)) * WORD_LENGTH);
+            break;
+        case MUTATE_AMOUNT:
+            write_amount(m, word, true);
+            break;
+        case MUTATE_SWAP:
+            memcpy(swapped, word, WORD_LENGTH);
+            memmove(word, other, WORD_LENGTH);
+            memcpy(other, swapped, WORD_LENGTH);
+            break;
+        case MUTATE_DUPLICATE:
+            if (length + WORD_LENGTH <= m->capacity) {
+                memmove(word + WORD_LENGTH, word, length - at);
+                length += WORD_LENGTH;
+            }
+            break;
+        case MUTATE_DELETE:
+            memmove(word, word + WORD_LENGTH, length - at - WORD_LENGTH);
+            length -= WORD_LENGTH;
+            break;
+        default:
+            length = LLVMFuzzerMutate(m->out, length, m->capacity);
+            break;
+    }
+    return length;
+}
+
+size_t LLVMFuzzerCustomMutator(uint8_t *data, size_t size, size_t max_size, unsigned int seed) {
+    mutator_t m = {.state = seed ? seed : 1, .registry = fuzz_registry(), .out = data};
+    uint8_t lookups[LOOKUPS_LENGTH];
+    size_t length;
+
+    if (max_size < SELECTOR_LENGTH + LOOKUPS_LENGTH) {
+        return LLVMFuzzerMutate(data, size, max_size);
+    }
+    m.capacity = max_size - LOOKUPS_LENGTH;
+
+    if (size < SELECTOR_LENGTH + LOOKUPS_LENGTH || next_random(&m) % 16 == 0) {
+        length = generate(&m);
+        if (length == 0) {
+            return LLVMFuzzerMutate(data, size, max_size);
+        }
+        memset(data + length, 0, LOOKUPS_LENGTH);
+        return length + LOOKUPS_LENGTH;
+    }
+
+    length = size - LOOKUPS_LENGTH;
+    memcpy(lookups, data + length, LOOKUPS_LENGTH);
+    for (uint32_t rounds = 1 + next_random(&m) % 4; rounds > 0; rounds--) {
+        length = mutate_word(&m, length);
+        if (length < SELECTOR_LENGTH) {
+            break;
+        }
+    }
+    memcpy(data + length, lookups, LOOKUPS_LENGTH);
+    return length + LOOKUPS_LENGTH;
+}
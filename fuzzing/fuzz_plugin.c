@@ -23,6 +23,10 @@ int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
     // Fake sha3 context
     cx_sha3_t sha3;
 
+    // Ethereum mainnet, so that the strategies are looked up in its registry
+    content.chainID.value[0] = 1;
+    content.chainID.length = 1;
+
     ethPluginSharedRO_t shared_ro;
     shared_ro.txContent = &content;
 
@@ -56,6 +60,12 @@ int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
     init_contract.pluginSharedRW = &shared_rw;
     init_contract.pluginContext = (uint8_t *) &context;
     init_contract.pluginContextLength = sizeof(context);
+    // the calldata is made of the parameters that fit before the token lookups
+    size_t parameters = 0;
+    if (size >= SELECTOR_SIZE + sizeof(extraInfo_t) * 2) {
+        parameters = (size - SELECTOR_SIZE - sizeof(extraInfo_t) * 2) / PARAMETER_LENGTH;
+    }
+    init_contract.dataSize = SELECTOR_SIZE + parameters * PARAMETER_LENGTH;
 
     handle_init_contract(&init_contract);
     if (init_contract.result != ETH_PLUGIN_RESULT_OK) {
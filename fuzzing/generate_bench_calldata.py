@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""
+Generate the calldata replayed by the `bench` tool from the transactions of the tests.
+
+The transactions of `tests/transactions.py` are matched to the selectors of `SELECTORS_LIST` in
+`src/plugin.h` by their first 4 bytes, and written as the `CALLDATA` table of `bench_plugin.c`,
+indexed by selector_t. Every selector needs a transaction, so a new selector can not be left out
+of the benchmark.
+"""
+
+import argparse
+import re
+import runpy
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+TRANSACTIONS = ROOT / "tests" / "transactions.py"
+PLUGIN_H = ROOT / "src" / "plugin.h"
+
+SELECTOR = re.compile(r"X\((\w+), 0x([0-9a-fA-F]{8}),")
+# hex characters per line of the generated table, one ABI word
+LINE_LENGTH = 64
+
+
+def selectors():
+    """Names and selectors of SELECTORS_LIST, in the order of selector_t"""
+    return [(name, value.lower()) for name, value in SELECTOR.findall(PLUGIN_H.read_text())]
+
+
+def transactions():
+    """Calldata of the tests by selector, without 0x prefix"""
+    calldata = {}
+    for name, value in runpy.run_path(str(TRANSACTIONS)).items():
+        if isinstance(value, str) and value.startswith("0x") and name.isupper():
+            calldata.setdefault(value[2:10].lower(), value[2:].lower())
+    return calldata
+
+
+def table(calldata) -> str:
+    lines = [
+        "// Generated by fuzzing/generate_bench_calldata.py from tests/transactions.py,",
+        "// do not edit",
+        "",
+        "#pragma once",
+        "",
+        "// Calldata of the functional tests, one per selector",
+        "static const char *const CALLDATA[SELECTOR_COUNT] = {",
+    ]
+    for name, data in calldata:
+        lines.append(f"    [{name}] =")
+        # the selector on its own line, then one ABI word per line
+        chunks = [data[:8]] + [data[i:i + LINE_LENGTH] for i in range(8, len(data), LINE_LENGTH)]
+        lines += [f'        "{chunk}"' for chunk in chunks]
+        lines[-1] += ","
+    lines.append("};")
+    return "\n".join(lines) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("output", type=Path, help="header to write")
+    args = parser.parse_args()
+
+    tests = transactions()
+    calldata = []
+    for name, selector in selectors():
+        if selector not in tests:
+            sys.exit(f"{TRANSACTIONS}: no transaction for {name} (0x{selector})")
+        calldata.append((name, tests[selector]))
+
+    args.output.parent.mkdir(parents=True, exist_ok=True)
+    args.output.write_text(table(calldata))
+
+
+if __name__ == "__main__":
+    main()
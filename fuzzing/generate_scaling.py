@@ -0,0 +1,42 @@
+#!/usr/bin/env python3
+"""
+Generate the transactions of the scaling benchmark, see `scaling_plugin.c`.
+
+Every point of the grid is a valid queueWithdrawals and completeQueuedWithdrawals transaction with
+1..N withdrawals of 1..M strategies each, drawn in turn from 1..T distinct strategies (and their
+tokens). One line is written per transaction: `withdrawals,strategies,tokens,calldata`.
+"""
+
+import argparse
+import sys
+
+from generate_seeds import STRATEGIES, complete_queued_withdrawals, queue_withdrawals
+
+
+def batches(withdrawals: int, strategies: int, tokens: int):
+    """Strategies of each withdrawal, cycling through the first `tokens` strategies"""
+    return [[(index * strategies + position) % tokens for position in range(strategies)]
+            for index in range(withdrawals)]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--withdrawals", type=int, default=8, help="maximum withdrawals (N)")
+    parser.add_argument("--strategies", type=int, default=8,
+                        help="maximum strategies per withdrawal (M)")
+    parser.add_argument("--tokens", type=int, default=len(STRATEGIES),
+                        choices=range(1, len(STRATEGIES) + 1),
+                        help="maximum distinct strategies and tokens (T)")
+    args = parser.parse_args()
+
+    for encode in (queue_withdrawals, complete_queued_withdrawals):
+        for withdrawals in range(1, args.withdrawals + 1):
+            for strategies in range(1, args.strategies + 1):
+                for tokens in range(1, min(args.tokens, withdrawals * strategies) + 1):
+                    calldata = encode(batches(withdrawals, strategies, tokens))
+                    sys.stdout.write(f"{withdrawals},{strategies},{tokens},{calldata.hex()}\n")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+"""
+Generate a seed corpus for the fuzzer.
+
+Each seed is a selector followed by its ABI encoded parameters, padded so that `fuzz_plugin.c`
+feeds every parameter to the plugin. `valid-*` seeds must be accepted by the plugin while
+`tampered-*` seeds reorder or shift the offsets announced in the head of the dynamic arrays and
+must be rejected by the offsets verification. With `--check`, the seeds are also run through the
+`validate` tool, which must accept the valid ones and reject the tampered ones in
+handle_provide_parameter or handle_finalize.
+"""
+
+import argparse
+import json
+import random
+import subprocess
+import sys
+from pathlib import Path
+
+STRATEGIES = [
+    "54945180db7943c0ed0fee7edab2bd24620256bc",  # cbETH
+    "93c4b944d05dfe6df7645a86cd2206016c51564d",  # stETH
+    "1bee69b7dfffa4e2d53c2a2df135c388ad25dcd2",  # rETH
+    "9d7ed45ee2e8fc5482fa2428f15c971e6369011d",  # ETHx
+]
+TOKENS = [
+    "be9895146f7af43049ca1c1ae358b0541ea49704",  # cbETH
+    "ae7ab96520de3a18e5e111b5eaab095312d7fe84",  # stETH
+    "ae78736cd615f374d3085123a210448e74fc6393",  # rETH
+    "a35b1b31ce002fbf2058d22f30f95d405200a15b",  # ETHx
+]
+WITHDRAWER = "b029e21e8d8a90c3fa58987a6bbf2b0563e5f6ab"
+
+QUEUE_WITHDRAWALS = bytes.fromhex("0dd8dd02")
+COMPLETE_QUEUED_WITHDRAWALS = bytes.fromhex("33404396")
+COMPLETE_QUEUED_WITHDRAWALS_SLASHING = bytes.fromhex("9435bb43")
+
+ADDRESS = "address"
+UINT = "uint"
+
+# callbacks of the plugin that check the offsets
+OFFSETS_CALLBACKS = ["handle_provide_parameter", "handle_finalize"]
+
+
+def word(value: int) -> bytes:
+    return value.to_bytes(32, "big")
+
+
+def is_dynamic(abi_type) -> bool:
+    if isinstance(abi_type, str):
+        return False
+    if abi_type[0] == "array":
+        return True
+    return any(is_dynamic(t) for t in abi_type[1])
+
+
+def encode(abi_type, value) -> bytes:
+    if abi_type == ADDRESS:
+        return word(int(value, 16))
+    if abi_type == UINT:
+        return word(value)
+    if abi_type[0] == "array":
+        return word(len(value)) + encode_sequence([abi_type[1]] * len(value), value)
+    return encode_sequence(abi_type[1], value)
+
+
+def encode_sequence(types, values) -> bytes:
+    heads, tails = [], []
+    offset = 32 * len(types)
+    for abi_type, value in zip(types, values):
+        encoded = encode(abi_type, value)
+        if is_dynamic(abi_type):
+            heads.append(word(offset))
+            tails.append(encoded)
+            offset += len(encoded)
+        else:
+            heads.append(encoded)
+    return b"".join(heads) + b"".join(tails)
+
+
+QUEUED_WITHDRAWAL_PARAMS = ("array", ("tuple", [("array", ADDRESS), ("array", UINT), ADDRESS]))
+WITHDRAWAL = ("tuple", [ADDRESS, ADDRESS, ADDRESS, UINT, UINT, ("array", ADDRESS), ("array", UINT)])
+
+
+def queue_withdrawals(batches):
+    params = [[[STRATEGIES[s] for s in batch], [1] * len(batch), WITHDRAWER] for batch in batches]
+    return QUEUE_WITHDRAWALS + encode_sequence([QUEUED_WITHDRAWAL_PARAMS], [params])
+
+
+def complete_queued_withdrawals(batches, slashing=False):
+    withdrawals = [[WITHDRAWER, WITHDRAWER, WITHDRAWER, nonce, 19000000 + nonce,
+                    [STRATEGIES[s] for s in batch], [1] * len(batch)]
+                   for nonce, batch in enumerate(batches)]
+    tokens = [[TOKENS[s] for s in batch] for batch in batches]
+    if slashing:
+        # middlewareTimesIndexes was removed by the slashing release
+        return COMPLETE_QUEUED_WITHDRAWALS_SLASHING + encode_sequence(
+            [("array", WITHDRAWAL), ("array", ("array", ADDRESS)), ("array", UINT)],
+            [withdrawals, tokens, [1] * len(batches)])
+    return COMPLETE_QUEUED_WITHDRAWALS + encode_sequence(
+        [("array", WITHDRAWAL), ("array", ("array", ADDRESS)), ("array", UINT), ("array", UINT)],
+        [withdrawals, tokens, [0] * len(batches), [1] * len(batches)])
+
+
+def words(calldata: bytes):
+    return [calldata[4 + 32 * i:4 + 32 * (i + 1)] for i in range((len(calldata) - 4) // 32)]
+
+
+def tamper(calldata: bytes, head: int, count: int, rng: random.Random):
+    """Yield the calldata with the `count` offsets starting at word `head` swapped or shifted"""
+    params = words(calldata)
+    first, second = rng.sample(range(count), 2)
+    if params[head + first] != params[head + second]:
+        swapped = list(params)
+        swapped[head + first], swapped[head + second] = swapped[head + second], swapped[head + first]
+        yield calldata[:4] + b"".join(swapped)
+    shifted = list(params)
+    shifted[head + second] = word(int.from_bytes(shifted[head + second], "big") + 32)
+    yield calldata[:4] + b"".join(shifted)
+
+
+def check(validate: Path, seeds) -> bool:
+    """Run the seeds through the `validate` tool, valid ones must be accepted and tampered ones
+    rejected by the offsets verification"""
+    names = list(seeds)
+    output = subprocess.run([str(validate)],
+                            input="".join(seeds[name].hex() + "\n" for name in names),
+                            capture_output=True, text=True, check=False).stdout.splitlines()
+    if len(output) != len(names):
+        print(f"{validate}: {len(output)} results for {len(names)} seeds", file=sys.stderr)
+        return False
+    passed = True
+    # one result per line, in order
+    for name, line in zip(names, output):
+        result = json.loads(line)
+        if name.startswith("tampered-"):
+            expected = (result["status"] == "rejected"
+                        and result["callback"] in OFFSETS_CALLBACKS)
+        else:
+            expected = result["status"] == "ok"
+        if not expected:
+            print(f"{name}: {line}", file=sys.stderr)
+            passed = False
+    return passed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("output", type=Path, help="corpus directory")
+    parser.add_argument("--padding", type=int, default=180,
+                        help="trailing bytes reserved by the harness for token lookups, "
+                             "2 * sizeof(extraInfo_t)")
+    parser.add_argument("--count", type=int, default=16, help="number of random batches")
+    parser.add_argument("--check", type=Path, metavar="VALIDATE",
+                        help="path of the `validate` tool to check the seeds with")
+    args = parser.parse_args()
+
+    rng = random.Random(0)
+    seeds = {}
+    for index in range(args.count):
+        batches = [rng.choices(range(len(STRATEGIES)), k=rng.randint(1, 3))
+                   for _ in range(rng.randint(2, 4))]
+        queue = queue_withdrawals(batches)
+        complete = complete_queued_withdrawals(batches)
+        seeds[f"valid-queue-{index}"] = queue
+        seeds[f"valid-complete-{index}"] = complete
+        seeds[f"valid-complete-slashing-{index}"] = complete_queued_withdrawals(batches, True)
+
+        tampered = list(tamper(queue, 2, len(batches), rng))
+        tampered += list(tamper(complete, 5, len(batches), rng))
+        # tokens array: its length is at the offset announced in the second head parameter
+        tokens_head = int.from_bytes(words(complete)[1], "big") // 32 + 1
+        tampered += list(tamper(complete, tokens_head, len(batches), rng))
+        for variant, calldata in enumerate(tampered):
+            seeds[f"tampered-{index}-{variant}"] = calldata
+
+    args.output.mkdir(parents=True, exist_ok=True)
+    for name, calldata in seeds.items():
+        (args.output / name).write_bytes(calldata + bytes(args.padding))
+    if args.check is not None and not check(args.check, seeds):
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
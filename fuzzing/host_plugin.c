@@ -0,0 +1,258 @@
+#include "plugin.h"
+#include "host_plugin.h"
+
+void handle_init_contract(ethPluginInitContract_t *parameters);
+void handle_provide_parameter(ethPluginProvideParameter_t *parameters);
+void handle_finalize(ethPluginFinalize_t *parameters);
+void handle_provide_token(ethPluginProvideInfo_t *parameters);
+void handle_query_contract_id(ethQueryContractID_t *parameters);
+void handle_query_contract_ui(ethQueryContractUI_t *parameters);
+
+// Memory the Ethereum application shares with the plugin
+typedef struct {
+    txContent_t content;
+    cx_sha3_t sha3;
+    ethPluginSharedRO_t ro;
+    ethPluginSharedRW_t rw;
+} shared_t;
+
+static void shared_init(shared_t *shared, uint64_t chain_id) {
+    memset(shared, 0, sizeof(*shared));
+    shared->ro.txContent = &shared->content;
+    shared->rw.sha3 = &shared->sha3;
+    // chain id as the big endian integer the Ethereum application provides
+    for (uint64_t id = chain_id; id != 0; id >>= 8) {
+        shared->content.chainID.length += 1;
+    }
+    for (uint8_t i = 0; i < shared->content.chainID.length; i++) {
+        shared->content.chainID.value[i] =
+            (uint8_t) (chain_id >> (8 * (shared->content.chainID.length - 1 - i)));
+    }
+}
+
+static const char *const STATUS_NAMES[] = {
+    [HOST_OK] = "ok",
+    [HOST_INVALID_CALLDATA] = "invalid_calldata",
+    [HOST_INIT_CONTRACT] = "handle_init_contract",
+    [HOST_PROVIDE_PARAMETER] = "handle_provide_parameter",
+    [HOST_FINALIZE] = "handle_finalize",
+    [HOST_PROVIDE_TOKEN] = "handle_provide_token",
+    [HOST_QUERY_CONTRACT_ID] = "handle_query_contract_id",
+    [HOST_QUERY_CONTRACT_UI] = "handle_query_contract_ui",
+};
+
+const char *host_status_name(host_status_t status) {
+    return STATUS_NAMES[status];
+}
+
+static int hex_digit(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+bool host_decode_hex(const char *hex, size_t length, uint8_t *out, size_t *size) {
+    if (length >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) {
+        hex += 2;
+        length -= 2;
+    }
+    if (length % 2 != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < length / 2; i++) {
+        int high = hex_digit(hex[2 * i]);
+        int low = hex_digit(hex[2 * i + 1]);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        out[i] = (uint8_t) (high << 4 | low);
+    }
+    *size = length / 2;
+    return true;
+}
+
+static bool valid_calldata(size_t size) {
+    return size >= SELECTOR_SIZE && (size - SELECTOR_SIZE) % PARAMETER_LENGTH == 0;
+}
+
+size_t host_context_size(void) {
+    return sizeof(context_t);
+}
+
+host_status_t host_plugin_init(const uint8_t *calldata,
+                               size_t size,
+                               uint64_t chain_id,
+                               uint8_t *context) {
+    ethPluginInitContract_t init_contract = {0};
+    shared_t shared;
+
+    if (!valid_calldata(size)) {
+        return HOST_INVALID_CALLDATA;
+    }
+    shared_init(&shared, chain_id);
+    init_contract.interfaceVersion = ETH_PLUGIN_INTERFACE_VERSION_LATEST;
+    init_contract.selector = calldata;
+    init_contract.pluginSharedRO = &shared.ro;
+    init_contract.pluginSharedRW = &shared.rw;
+    init_contract.pluginContext = context;
+    init_contract.pluginContextLength = sizeof(context_t);
+    init_contract.dataSize = size;
+    handle_init_contract(&init_contract);
+    return (init_contract.result == ETH_PLUGIN_RESULT_OK) ? HOST_OK : HOST_INIT_CONTRACT;
+}
+
+static void call_hook(host_hook_t *hook,
+                      host_status_t callback,
+                      const uint8_t *context,
+                      size_t position,
+                      void *arg) {
+    if (hook != NULL) {
+        hook(callback, context, position, arg);
+    }
+}
+
+static host_status_t resume(const uint8_t *calldata,
+                            size_t size,
+                            uint64_t chain_id,
+                            uint8_t *context,
+                            size_t offset,
+                            host_hook_t *hook,
+                            void *arg,
+                            host_screen_t screens[HOST_MAX_SCREENS],
+                            size_t *count,
+                            size_t *position) {
+    ethPluginProvideParameter_t provide_param = {0};
+    ethPluginFinalize_t finalize = {0};
+    ethPluginProvideInfo_t provide_info = {0};
+    ethQueryContractID_t query_id = {0};
+    ethQueryContractUI_t query_ui = {0};
+    shared_t shared;
+    const uint8_t address[ADDRESS_LENGTH] = {0};
+
+    *count = 0;
+    *position = 0;
+    if (!valid_calldata(size) || offset < SELECTOR_SIZE || offset > size ||
+        (offset - SELECTOR_SIZE) % PARAMETER_LENGTH != 0) {
+        return HOST_INVALID_CALLDATA;
+    }
+    shared_init(&shared, chain_id);
+
+    provide_param.pluginContext = context;
+    provide_param.pluginSharedRO = &shared.ro;
+    provide_param.pluginSharedRW = &shared.rw;
+    for (size_t i = offset; i < size; i += PARAMETER_LENGTH) {
+        call_hook(hook, HOST_PROVIDE_PARAMETER, context, i, arg);
+        provide_param.parameter = calldata + i;
+        provide_param.parameterOffset = i;
+        handle_provide_parameter(&provide_param);
+        if (provide_param.result != ETH_PLUGIN_RESULT_OK) {
+            *position = i;
+            return HOST_PROVIDE_PARAMETER;
+        }
+    }
+
+    finalize.pluginContext = context;
+    finalize.address = address;
+    finalize.pluginSharedRO = &shared.ro;
+    finalize.pluginSharedRW = &shared.rw;
+    call_hook(hook, HOST_FINALIZE, context, size, arg);
+    handle_finalize(&finalize);
+    if (finalize.result != ETH_PLUGIN_RESULT_OK) {
+        return HOST_FINALIZE;
+    }
+
+    if (finalize.tokenLookup1 || finalize.tokenLookup2) {
+        // the tokens are not known to the Ethereum application
+        provide_info.pluginContext = context;
+        provide_info.pluginSharedRO = &shared.ro;
+        provide_info.pluginSharedRW = &shared.rw;
+        call_hook(hook, HOST_PROVIDE_TOKEN, context, 0, arg);
+        handle_provide_token(&provide_info);
+        if (provide_info.result != ETH_PLUGIN_RESULT_OK) {
+            return HOST_PROVIDE_TOKEN;
+        }
+    }
+
+    query_id.pluginContext = context;
+    query_id.pluginSharedRO = &shared.ro;
+    query_id.pluginSharedRW = &shared.rw;
+    query_id.name = screens[0].title;
+    query_id.nameLength = sizeof(screens[0].title);
+    query_id.version = screens[0].msg;
+    query_id.versionLength = sizeof(screens[0].msg);
+    call_hook(hook, HOST_QUERY_CONTRACT_ID, context, 0, arg);
+    handle_query_contract_id(&query_id);
+    if (query_id.result != ETH_PLUGIN_RESULT_OK) {
+        return HOST_QUERY_CONTRACT_ID;
+    }
+
+    query_ui.pluginContext = context;
+    query_ui.pluginSharedRO = &shared.ro;
+    query_ui.pluginSharedRW = &shared.rw;
+    for (int i = 0; i < finalize.numScreens + provide_info.additionalScreens; i++) {
+        host_screen_t *screen = &screens[1 + i];
+        query_ui.title = screen->title;
+        query_ui.titleLength = sizeof(screen->title);
+        query_ui.msg = screen->msg;
+        query_ui.msgLength = sizeof(screen->msg);
+        query_ui.screenIndex = i;
+        call_hook(hook, HOST_QUERY_CONTRACT_UI, context, i, arg);
+        handle_query_contract_ui(&query_ui);
+        if (query_ui.result != ETH_PLUGIN_RESULT_OK) {
+            *position = i;
+            return HOST_QUERY_CONTRACT_UI;
+        }
+    }
+    *count = 1 + finalize.numScreens + provide_info.additionalScreens;
+    return HOST_OK;
+}
+
+host_status_t host_plugin_resume(const uint8_t *calldata,
+                                 size_t size,
+                                 uint64_t chain_id,
+                                 uint8_t *context,
+                                 size_t offset,
+                                 host_hook_t *hook,
+                                 void *arg,
+                                 host_screen_t screens[HOST_MAX_SCREENS],
+                                 size_t *count,
+                                 size_t *position) {
+    host_status_t status =
+        resume(calldata, size, chain_id, context, offset, hook, arg, screens, count, position);
+
+    call_hook(hook, HOST_OK, context, 0, arg);
+    return status;
+}
+
+host_status_t host_plugin_run(const uint8_t *calldata,
+                              size_t size,
+                              uint64_t chain_id,
+                              host_screen_t screens[HOST_MAX_SCREENS],
+                              size_t *count,
+                              size_t *position) {
+    context_t context;
+    host_status_t status = host_plugin_init(calldata, size, chain_id, (uint8_t *) &context);
+
+    *count = 0;
+    *position = 0;
+    if (status != HOST_OK) {
+        return status;
+    }
+    return host_plugin_resume(calldata,
+                              size,
+                              chain_id,
+                              (uint8_t *) &context,
+                              SELECTOR_SIZE,
+                              NULL,
+                              NULL,
+                              screens,
+                              count,
+                              position);
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Host API of the plugin: a transaction goes through the whole plugin flow, init to
+// query_contract_ui, and the screens the device would display are returned as text. Used by the
+// `validate` tool and, built as the `plugin_host` shared library, by the text snapshot tests of
+// tests/tests/test_host_parser.py. The run can also be split at any parameter: the context of the
+// plugin is then saved and resumed by the `replay` tool. The `scaling` and `bench` tools run their
+// transactions through it as well.
+
+#define HOST_TITLE_LENGTH 32
+// 2^256 is 78 digits long
+#define HOST_MSG_LENGTH 79
+// the ID screen, then the numScreens and additionalScreens of the plugin, 8-bit each
+#define HOST_MAX_SCREENS (1 + 2 * UINT8_MAX)
+
+typedef struct {
+    char title[HOST_TITLE_LENGTH];
+    char msg[HOST_MSG_LENGTH];
+} host_screen_t;
+
+// Callback that rejected the transaction
+typedef enum {
+    HOST_OK = 0,
+    HOST_INVALID_CALLDATA,  // not a selector followed by 32-byte parameters
+    HOST_INIT_CONTRACT,
+    HOST_PROVIDE_PARAMETER,
+    HOST_FINALIZE,
+    HOST_PROVIDE_TOKEN,
+    HOST_QUERY_CONTRACT_ID,
+    HOST_QUERY_CONTRACT_UI,
+} host_status_t;
+
+/**
+ * @returns name of a status: "ok", "invalid_calldata" or the name of the callback
+ */
+const char *host_status_name(host_status_t status);
+
+/**
+ * @brief Decode hex digits, with or without 0x prefix
+ *
+ * @param hex: hex digits
+ * @param length: number of characters of `hex`, prefix included
+ * @param out: set to the bytes, length / 2 bytes long at most, can be `hex` to decode in place
+ * @param size: set to the number of bytes
+ *
+ * @returns false if the hex is malformed
+ */
+bool host_decode_hex(const char *hex, size_t length, uint8_t *out, size_t *size);
+
+/**
+ * @brief Run a transaction through the plugin
+ *
+ * @param calldata: selector followed by the parameters
+ * @param size: calldata size
+ * @param chain_id: chain id of the transaction
+ * @param screens: set to the screens, the ID screen (plugin name and label) first
+ * @param count: set to the number of screens
+ * @param position: set to the calldata offset of the rejected parameter for
+ * HOST_PROVIDE_PARAMETER, or to the index of the rejected screen for HOST_QUERY_CONTRACT_UI
+ *
+ * @returns HOST_OK, or the callback that rejected the transaction
+ */
+host_status_t host_plugin_run(const uint8_t *calldata,
+                              size_t size,
+                              uint64_t chain_id,
+                              host_screen_t screens[HOST_MAX_SCREENS],
+                              size_t *count,
+                              size_t *position);
+
+/**
+ * @brief Called by host_plugin_resume before each callback of the plugin, and once more with
+ * HOST_OK when the run is over, whatever its result
+ *
+ * @param callback: callback about to be called, HOST_OK at the end of the run
+ * @param context: context of the plugin, host_context_size() bytes
+ * @param position: calldata offset of the parameter for HOST_PROVIDE_PARAMETER, calldata size for
+ * HOST_FINALIZE, index of the screen for HOST_QUERY_CONTRACT_UI, 0 otherwise
+ * @param arg: argument given to host_plugin_resume
+ */
+typedef void host_hook_t(host_status_t callback,
+                         const uint8_t *context,
+                         size_t position,
+                         void *arg);
+
+/**
+ * @returns size of the context of the plugin, that is of a snapshot
+ */
+size_t host_context_size(void);
+
+/**
+ * @brief Start a transaction, up to its first parameter
+ *
+ * @param calldata: selector followed by the parameters
+ * @param size: calldata size
+ * @param chain_id: chain id of the transaction
+ * @param context: set to the context of the plugin, host_context_size() bytes
+ *
+ * @returns HOST_OK, HOST_INVALID_CALLDATA or HOST_INIT_CONTRACT
+ */
+host_status_t host_plugin_init(const uint8_t *calldata,
+                               size_t size,
+                               uint64_t chain_id,
+                               uint8_t *context);
+
+/**
+ * @brief Run the rest of a transaction from the context of the plugin before one of its
+ * parameters, see host_plugin_run
+ *
+ * @param calldata: selector followed by the parameters, only read from `offset`
+ * @param size: calldata size
+ * @param chain_id: chain id of the transaction
+ * @param context: context of the plugin before the parameter at `offset`, updated
+ * @param offset: calldata offset of the parameter to resume from
+ * @param hook: called with the context before each callback, NULL if not needed
+ * @param arg: argument of `hook`
+ * @param screens: set to the screens, the ID screen (plugin name and label) first
+ * @param count: set to the number of screens
+ * @param position: as in host_plugin_run
+ *
+ * @returns HOST_OK, or the callback that rejected the transaction
+ */
+host_status_t host_plugin_resume(const uint8_t *calldata,
+                                 size_t size,
+                                 uint64_t chain_id,
+                                 uint8_t *context,
+                                 size_t offset,
+                                 host_hook_t *hook,
+                                 void *arg,
+                                 host_screen_t screens[HOST_MAX_SCREENS],
+                                 size_t *count,
+                                 size_t *position);
@@ -0,0 +1,21 @@
+#include "plugin.h"
+#include "lcx_common.h"
+#include "lcx_hash.h"
+#include "lcx_sha3.h"
+
+// Keccak-256 of the address checksums computed with cxng, for the host tools that must display
+// the same addresses as the device. The other targets keep the mock of mocks.c.
+cx_err_t cx_keccak_256_hash_iovec(const cx_iovec_t *iovec,
+                                  size_t iovec_len,
+                                  uint8_t digest[static CX_KECCAK_256_SIZE]) {
+    cx_sha3_t hash;
+    cx_err_t error = cx_keccak_init_no_throw(&hash, 256);
+
+    for (size_t i = 0; error == CX_OK && i < iovec_len; i++) {
+        error = cx_sha3_update(&hash, iovec[i].iov_base, iovec[i].iov_len);
+    }
+    if (error == CX_OK) {
+        error = cx_sha3_final(&hash, digest);
+    }
+    return error;
+}
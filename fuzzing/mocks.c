@@ -37,11 +37,21 @@ size_t strlcpy(char *dst, const char *src, size_t size) {
     return (srclen);
 }
 
+#ifndef REAL_KECCAK
+// see keccak.c for targets that need the real hash
 cx_err_t cx_keccak_256_hash_iovec(const cx_iovec_t *iovec,
                                   size_t iovec_len,
                                   uint8_t digest[static CX_KECCAK_256_SIZE]) {
     return CX_OK;
 }
+#endif
+
+void cx_rng_no_throw(uint8_t *buffer, size_t len) {
+    // deterministic "randomness" so that crashes can be replayed
+    for (size_t i = 0; i < len; i++) {
+        buffer[i] = (uint8_t) (0x5A + i * 37);
+    }
+}
 
 void os_sched_exit(bolos_task_status_t exit_code) {
     return;
@@ -0,0 +1,436 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "plugin.h"
+#include "host_plugin.h"
+
+// Snapshots and deterministic replay of a transaction on the host, run with
+//   ./build/replay [-c chain_id] record CALLDATA > snapshots.jsonl
+//   ./build/replay [-c chain_id] resume SNAPSHOTS OFFSET CALLDATA
+//   ./build/replay [-c chain_id] bisect CALLDATA [REFERENCE]
+// CALLDATA is hex (0x prefixed) or a file holding the hex on its first line.
+//
+// `record` writes the context of the plugin before each parameter, and before handle_finalize,
+// as one JSON line, followed by the result of the transaction. `resume` runs the transaction
+// again from one of these snapshots. `bisect` finds the first parameter that makes a transaction
+// rejected, along with the state of the plugin before it. Rejections by handle_provide_parameter
+// point at their parameter directly. Rejections of the whole calldata, by handle_finalize, need a
+// REFERENCE transaction of the same selector and size that is accepted: the calldata is spliced
+// with the parameters of the reference from a given offset, and the offset is bisected. The
+// randomness of the plugin is deterministic on the host (see mocks.c), so the runs are too.
+
+#define MAINNET_CHAIN_ID 1
+
+static const char *const PHASE_NAMES[] = {
+    [PARSER_LENGTH] = "length",
+    [PARSER_HEAD] = "head",
+    [PARSER_TAIL] = "tail",
+};
+
+typedef struct {
+    uint8_t *data;
+    size_t size;
+} calldata_t;
+
+// Context of the plugin before each parameter, then before handle_finalize
+typedef struct {
+    context_t *contexts;
+    size_t count;
+} snapshots_t;
+
+/**
+ * @brief Decode hex digits, with or without 0x prefix
+ *
+ * @param hex: hex digits, up to the end of the string or of the line
+ * @param out: set to the bytes, allocated
+ * @param size: set to the number of bytes
+ *
+ * @returns false if the hex is malformed
+ */
+static bool decode_hex(const char *hex, uint8_t **out, size_t *size) {
+    size_t length = strcspn(hex, "\"\r\n");
+
+    if ((*out = malloc(length / 2 + 1)) == NULL) {
+        return false;
+    }
+    if (!host_decode_hex(hex, length, *out, size)) {
+        free(*out);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Read a calldata argument, hex or the first line of a file
+ */
+static calldata_t read_calldata(const char *argument) {
+    calldata_t calldata = {0};
+    char *line = NULL;
+    size_t capacity = 0;
+    bool decoded;
+
+    if (argument[0] == '0' && (argument[1] == 'x' || argument[1] == 'X')) {
+        decoded = decode_hex(argument, &calldata.data, &calldata.size);
+    } else {
+        FILE *file = fopen(argument, "r");
+        if (file == NULL) {
+            perror(argument);
+            exit(EXIT_FAILURE);
+        }
+        decoded = getline(&line, &capacity, file) >= 0 &&
+                  decode_hex(line, &calldata.data, &calldata.size);
+        free(line);
+        fclose(file);
+    }
+    if (!decoded) {
+        fprintf(stderr, "%s: invalid hex calldata\n", argument);
+        exit(EXIT_FAILURE);
+    }
+    return calldata;
+}
+
+static void print_hex(const uint8_t *data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        printf("%02x", data[i]);
+    }
+}
+
+/**
+ * @brief Print the state of the plugin, decoded and as the raw context
+ *
+ * @param context: context of the plugin
+ * @param offset: calldata offset of the next parameter
+ */
+static void print_state(const context_t *context, size_t offset) {
+    const parser_t *parser = &context->parser;
+
+    printf("\"offset\": %zu, \"selector\": %d, \"parser_offset\": %d, \"skip_to\": %d, "
+           "\"frames\": [",
+           offset,
+           context->selectorIndex,
+           parser->offset,
+           context->go_to_offset ? parser->offset : 0);
+    for (uint8_t i = 0; i < parser->depth && i < PARSER_MAX_DEPTH; i++) {
+        const parser_frame_t *frame = &parser->frames[i];
+        printf("%s{\"node\": %d, \"phase\": \"%s\", \"base\": %d, \"index\": %d, \"count\": %d}",
+               (i == 0) ? "" : ", ",
+               frame->node,
+               frame->phase <= PARSER_TAIL ? PHASE_NAMES[frame->phase] : "invalid",
+               frame->base,
+               frame->index,
+               frame->count);
+    }
+    printf("], \"context\": \"");
+    print_hex((const uint8_t *) context, sizeof(*context));
+    printf("\"");
+}
+
+static void print_result(host_status_t status, size_t position) {
+    printf("{\"status\": \"%s\"", host_status_name(status));
+    if (status == HOST_PROVIDE_PARAMETER) {
+        printf(", \"offset\": %zu", position);
+    } else if (status == HOST_QUERY_CONTRACT_UI) {
+        printf(", \"screen\": %zu", position);
+    }
+    printf("}\n");
+}
+
+static void save_snapshot(host_status_t callback,
+                          const uint8_t *context,
+                          size_t position,
+                          void *arg) {
+    snapshots_t *snapshots = arg;
+
+    (void) position;
+    // before each parameter and before handle_finalize
+    if (callback == HOST_PROVIDE_PARAMETER || callback == HOST_FINALIZE) {
+        memcpy(&snapshots->contexts[snapshots->count++], context, sizeof(context_t));
+    }
+}
+
+/**
+ * @brief Run a transaction and save the context of the plugin before each of its parameters
+ *
+ * @param calldata: transaction to run
+ * @param chain_id: chain id of the transaction
+ * @param snapshots: set to the snapshots, allocated
+ * @param screens: set to the screens
+ * @param count: set to the number of screens
+ * @param position: as in host_plugin_run
+ *
+ * @returns HOST_OK, or the callback that rejected the transaction
+ */
+static host_status_t record(const calldata_t *calldata,
+                            uint64_t chain_id,
+                            snapshots_t *snapshots,
+                            host_screen_t *screens,
+                            size_t *count,
+                            size_t *position) {
+    context_t context;
+    host_status_t status;
+
+    snapshots->count = 0;
+    snapshots->contexts =
+        calloc(calldata->size / PARAMETER_LENGTH + 1, sizeof(*snapshots->contexts));
+    if (snapshots->contexts == NULL) {
+        perror("calloc");
+        exit(EXIT_FAILURE);
+    }
+    *count = 0;
+    *position = 0;
+    status = host_plugin_init(calldata->data, calldata->size, chain_id, (uint8_t *) &context);
+    if (status != HOST_OK) {
+        return status;
+    }
+    return host_plugin_resume(calldata->data,
+                              calldata->size,
+                              chain_id,
+                              (uint8_t *) &context,
+                              SELECTOR_SIZE,
+                              save_snapshot,
+                              snapshots,
+                              screens,
+                              count,
+                              position);
+}
+
+/**
+ * @brief Find the snapshot taken before a parameter in the output of `record`
+ *
+ * @param path: output of `record`
+ * @param offset: calldata offset of the parameter
+ * @param context: set to the context of the snapshot
+ *
+ * @returns false if there is no snapshot at `offset`
+ */
+static bool load_snapshot(const char *path, size_t offset, context_t *context) {
+    FILE *file = fopen(path, "r");
+    char *line = NULL;
+    size_t capacity = 0;
+    bool found = false;
+
+    if (file == NULL) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+    while (!found && getline(&line, &capacity, file) >= 0) {
+        const char *hex = strstr(line, "\"context\": \"");
+        unsigned long long line_offset;
+        uint8_t *bytes;
+        size_t size;
+
+        if (hex == NULL || sscanf(line, "{\"offset\": %llu,", &line_offset) != 1 ||
+            line_offset != offset) {
+            continue;
+        }
+        if (!decode_hex(hex + strlen("\"context\": \""), &bytes, &size)) {
+            break;
+        }
+        if (size == sizeof(*context)) {
+            memcpy(context, bytes, sizeof(*context));
+            found = true;
+        }
+        free(bytes);
+        if (!found) {
+            fprintf(stderr, "%s: snapshot of another build of the plugin\n", path);
+            break;
+        }
+    }
+    free(line);
+    fclose(file);
+    return found;
+}
+
+static int record_command(const calldata_t *calldata, uint64_t chain_id, host_screen_t *screens) {
+    snapshots_t snapshots;
+    size_t count;
+    size_t position;
+    host_status_t status = record(calldata, chain_id, &snapshots, screens, &count, &position);
+
+    for (size_t i = 0; i < snapshots.count; i++) {
+        printf("{");
+        print_state(&snapshots.contexts[i], SELECTOR_SIZE + i * PARAMETER_LENGTH);
+        printf("}\n");
+    }
+    print_result(status, position);
+    free(snapshots.contexts);
+    return (status == HOST_OK) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static int resume_command(const calldata_t *calldata,
+                          uint64_t chain_id,
+                          const char *path,
+                          size_t offset,
+                          host_screen_t *screens) {
+    context_t context;
+    size_t count;
+    size_t position;
+    host_status_t status;
+
+    if (!load_snapshot(path, offset, &context)) {
+        fprintf(stderr, "%s: no snapshot at offset %zu\n", path, offset);
+        return EXIT_FAILURE;
+    }
+    status = host_plugin_resume(calldata->data,
+                                calldata->size,
+                                chain_id,
+                                (uint8_t *) &context,
+                                offset,
+                                NULL,
+                                NULL,
+                                screens,
+                                &count,
+                                &position);
+    for (size_t i = 0; i < count; i++) {
+        printf("%s: %s\n", screens[i].title, screens[i].msg);
+    }
+    print_result(status, position);
+    return (status == HOST_OK) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief Resume the reference from a snapshot of the transaction, that is run the transaction
+ * spliced with the parameters of the reference from `offset`
+ *
+ * @returns true if the spliced transaction is accepted
+ */
+static bool accepted_spliced(const calldata_t *reference,
+                             uint64_t chain_id,
+                             const context_t *snapshot,
+                             size_t offset,
+                             host_screen_t *screens) {
+    context_t context = *snapshot;
+    size_t count;
+    size_t position;
+
+    return host_plugin_resume(reference->data,
+                              reference->size,
+                              chain_id,
+                              (uint8_t *) &context,
+                              offset,
+                              NULL,
+                              NULL,
+                              screens,
+                              &count,
+                              &position) == HOST_OK;
+}
+
+static int bisect_command(const calldata_t *calldata,
+                          const calldata_t *reference,
+                          uint64_t chain_id,
+                          host_screen_t *screens) {
+    snapshots_t snapshots;
+    size_t count;
+    size_t position;
+    host_status_t status = record(calldata, chain_id, &snapshots, screens, &count, &position);
+    size_t parameters = snapshots.count;
+    int result = EXIT_FAILURE;
+
+    if (status == HOST_OK) {
+        fprintf(stderr, "the transaction is accepted\n");
+        result = EXIT_SUCCESS;
+    } else if (status == HOST_PROVIDE_PARAMETER) {
+        // rejected by the parameter itself, the snapshot is the state before it
+        printf("{\"callback\": \"%s\", ", host_status_name(status));
+        print_state(&snapshots.contexts[parameters - 1], position);
+        printf("}\n");
+    } else if (status == HOST_INVALID_CALLDATA || status == HOST_INIT_CONTRACT) {
+        print_result(status, position);
+    } else if (reference == NULL) {
+        print_result(status, position);
+        fprintf(stderr, "rejected after the last parameter, give an accepted REFERENCE\n");
+    } else if (reference->size != calldata->size ||
+               memcmp(reference->data, calldata->data, SELECTOR_SIZE) != 0 ||
+               !accepted_spliced(reference,
+                                 chain_id,
+                                 &snapshots.contexts[0],
+                                 SELECTOR_SIZE,
+                                 screens)) {
+        fprintf(stderr, "REFERENCE must be accepted, with the selector and size of CALLDATA\n");
+    } else {
+        // accepted with the first `good` parameters of the calldata, rejected with `bad`
+        size_t good = 0;
+        size_t bad = parameters - 1;
+        while (bad - good > 1) {
+            size_t middle = good + (bad - good) / 2;
+            if (accepted_spliced(reference,
+                                 chain_id,
+                                 &snapshots.contexts[middle],
+                                 SELECTOR_SIZE + middle * PARAMETER_LENGTH,
+                                 screens)) {
+                good = middle;
+            } else {
+                bad = middle;
+            }
+        }
+        printf("{\"callback\": \"%s\", ", host_status_name(status));
+        print_state(&snapshots.contexts[good], SELECTOR_SIZE + good * PARAMETER_LENGTH);
+        printf(", \"parameter\": \"");
+        print_hex(calldata->data + SELECTOR_SIZE + good * PARAMETER_LENGTH, PARAMETER_LENGTH);
+        printf("\", \"reference\": \"");
+        print_hex(reference->data + SELECTOR_SIZE + good * PARAMETER_LENGTH, PARAMETER_LENGTH);
+        printf("\"}\n");
+    }
+    free(snapshots.contexts);
+    return result;
+}
+
+static int usage(const char *name) {
+    fprintf(stderr,
+            "Usage: %s [-c chain_id] record CALLDATA\n"
+            "       %s [-c chain_id] resume SNAPSHOTS OFFSET CALLDATA\n"
+            "       %s [-c chain_id] bisect CALLDATA [REFERENCE]\n",
+            name,
+            name,
+            name);
+    return EXIT_FAILURE;
+}
+
+int main(int argc, char **argv) {
+    const char *name = argv[0];
+    uint64_t chain_id = MAINNET_CHAIN_ID;
+    host_screen_t *screens = malloc(HOST_MAX_SCREENS * sizeof(host_screen_t));
+    calldata_t calldata;
+    calldata_t reference = {0};
+    int status;
+    int option;
+
+    while ((option = getopt(argc, argv, "c:")) != -1) {
+        if (option != 'c') {
+            return usage(name);
+        }
+        chain_id = strtoull(optarg, NULL, 0);
+    }
+    if (screens == NULL) {
+        perror("malloc");
+        return EXIT_FAILURE;
+    }
+    argv += optind;
+    argc -= optind;
+
+    if (argc == 2 && strcmp(argv[0], "record") == 0) {
+        calldata = read_calldata(argv[1]);
+        status = record_command(&calldata, chain_id, screens);
+    } else if (argc == 4 && strcmp(argv[0], "resume") == 0) {
+        calldata = read_calldata(argv[3]);
+        status = resume_command(&calldata, chain_id, argv[1], strtoul(argv[2], NULL, 0), screens);
+    } else if ((argc == 2 || argc == 3) && strcmp(argv[0], "bisect") == 0) {
+        calldata = read_calldata(argv[1]);
+        if (argc == 3) {
+            reference = read_calldata(argv[2]);
+        }
+        status = bisect_command(&calldata, argc == 3 ? &reference : NULL, chain_id, screens);
+        if (argc == 3) {
+            free(reference.data);
+        }
+    } else {
+        free(screens);
+        return usage(name);
+    }
+    free(calldata.data);
+    free(screens);
+    return status;
+}
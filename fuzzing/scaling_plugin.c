@@ -0,0 +1,270 @@
+#define _GNU_SOURCE
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "plugin.h"
+#include "host_plugin.h"
+
+// Scaling curves of the plugin on the host, run with
+// `python3 generate_scaling.py | ./build/scaling [-r repetitions] [-e exponent]`.
+// Every line of the input is a point of the grid, `withdrawals,strategies,tokens,calldata`. The
+// transaction goes through the whole plugin flow (see host_plugin.h) and one CSV line is written
+// per point with the number of parameters, of Keccak-256 hashes and of getEthDisplayableAddress
+// calls, the number of screens and the median wall time of a run. The cost of each selector is
+// then fitted as a power of its number of parameters, exponents above the threshold are reported
+// on stderr as super-linear terms and make the exit status 1.
+
+#define DEFAULT_REPETITIONS 51
+#define DEFAULT_EXPONENT    1.15
+#define MAINNET_CHAIN_ID    1
+
+typedef enum {
+    METRIC_NS = 0,
+    METRIC_HASHES,
+    METRIC_ADDRESSES,
+    METRIC_SCREENS,
+    METRIC_COUNT,
+} metric_t;
+
+static const char *const METRIC_NAMES[METRIC_COUNT] = {
+    "ns",
+    "hashes",
+    "displayable_addresses",
+    "screens",
+};
+
+#define TO_NAME(name, selector, label, screens, finalize, handler) #name,
+static const char *const SELECTOR_NAMES[SELECTOR_COUNT] = {SELECTORS_LIST(TO_NAME)};
+
+// Accepted points of a selector, as logarithms for the power fits
+typedef struct {
+    double *parameters;
+    double *metrics[METRIC_COUNT];
+    size_t count;
+    size_t capacity;
+} curve_t;
+
+// Calls counted by wrapping the functions at link time, see CMakeLists.txt
+static uint64_t hashes;
+static uint64_t addresses;
+
+cx_err_t __real_cx_keccak_256_hash_iovec(const cx_iovec_t *iovec,
+                                         size_t iovec_len,
+                                         uint8_t digest[static CX_KECCAK_256_SIZE]);
+bool __real_getEthDisplayableAddress(uint8_t *in, char *out, size_t out_len, uint64_t chainId);
+
+cx_err_t __wrap_cx_keccak_256_hash_iovec(const cx_iovec_t *iovec,
+                                         size_t iovec_len,
+                                         uint8_t digest[static CX_KECCAK_256_SIZE]) {
+    hashes++;
+    return __real_cx_keccak_256_hash_iovec(iovec, iovec_len, digest);
+}
+
+bool __wrap_getEthDisplayableAddress(uint8_t *in, char *out, size_t out_len, uint64_t chainId) {
+    addresses++;
+    return __real_getEthDisplayableAddress(in, out, out_len, chainId);
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *) a;
+    uint64_t y = *(const uint64_t *) b;
+    return (x > y) - (x < y);
+}
+
+static int selector_index(const uint8_t *calldata, size_t size) {
+    if (size >= SELECTOR_SIZE) {
+        for (int i = 0; i < SELECTOR_COUNT; i++) {
+            if (SELECTORS[i] == U4BE(calldata, 0)) {
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
+static void curve_add(curve_t *curve, double parameters, const uint64_t metrics[METRIC_COUNT]) {
+    if (curve->count == curve->capacity) {
+        curve->capacity = curve->capacity ? 2 * curve->capacity : 64;
+        curve->parameters = realloc(curve->parameters, curve->capacity * sizeof(double));
+        bool failed = curve->parameters == NULL;
+        for (int metric = 0; metric < METRIC_COUNT; metric++) {
+            curve->metrics[metric] =
+                realloc(curve->metrics[metric], curve->capacity * sizeof(double));
+            failed |= curve->metrics[metric] == NULL;
+        }
+        if (failed) {
+            perror("realloc");
+            exit(EXIT_FAILURE);
+        }
+    }
+    curve->parameters[curve->count] = log(parameters);
+    for (int metric = 0; metric < METRIC_COUNT; metric++) {
+        // metrics that can be 0 are shifted by one, a constant count fits a null exponent
+        curve->metrics[metric][curve->count] = log((double) metrics[metric] + 1);
+    }
+    curve->count++;
+}
+
+/**
+ * @brief Least squares slope of a metric against the number of parameters, both as logarithms,
+ * that is the exponent of the best power fit
+ *
+ * @returns the exponent, NAN when the parameters do not vary
+ */
+static double exponent(const curve_t *curve, metric_t metric) {
+    double mean_x = 0;
+    double mean_y = 0;
+    double covariance = 0;
+    double variance = 0;
+
+    for (size_t i = 0; i < curve->count; i++) {
+        mean_x += curve->parameters[i] / curve->count;
+        mean_y += curve->metrics[metric][i] / curve->count;
+    }
+    for (size_t i = 0; i < curve->count; i++) {
+        double dx = curve->parameters[i] - mean_x;
+        covariance += dx * (curve->metrics[metric][i] - mean_y);
+        variance += dx * dx;
+    }
+    return variance > 0 ? covariance / variance : NAN;
+}
+
+int main(int argc, char **argv) {
+    curve_t curves[SELECTOR_COUNT] = {0};
+    unsigned long repetitions = DEFAULT_REPETITIONS;
+    double threshold = DEFAULT_EXPONENT;
+    host_screen_t *screens = malloc(HOST_MAX_SCREENS * sizeof(host_screen_t));
+    uint64_t *times = NULL;
+    char *line = NULL;
+    size_t capacity = 0;
+    ssize_t length;
+    unsigned long number = 0;
+    int status = EXIT_SUCCESS;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "r:e:")) != -1) {
+        if (opt == 'r') {
+            repetitions = strtoul(optarg, NULL, 10);
+        } else if (opt == 'e') {
+            threshold = strtod(optarg, NULL);
+        } else {
+            repetitions = 0;
+            break;
+        }
+    }
+    if (repetitions == 0 || threshold <= 0 || optind != argc) {
+        fprintf(stderr, "Usage: %s [-r repetitions] [-e exponent] < points\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    times = malloc(repetitions * sizeof(uint64_t));
+    if (screens == NULL || times == NULL) {
+        perror("malloc");
+        return EXIT_FAILURE;
+    }
+
+    printf("selector,withdrawals,strategies,tokens,parameters,hashes,displayable_addresses,"
+           "screens,ns,status\n");
+    while ((length = getline(&line, &capacity, stdin)) >= 0) {
+        unsigned long withdrawals, strategies, tokens;
+        int consumed = 0;
+        size_t count = 0, position = 0, size;
+        host_status_t result;
+        uint64_t metrics[METRIC_COUNT];
+        int selector;
+
+        number++;
+        if (sscanf(line, "%lu,%lu,%lu,%n", &withdrawals, &strategies, &tokens, &consumed) != 3 ||
+            consumed == 0 ||
+            !host_decode_hex(line + consumed,
+                             strcspn(line + consumed, "\r\n"),
+                             (uint8_t *) line + consumed,
+                             &size) ||
+            size == 0) {
+            fprintf(stderr, "line %lu: expected withdrawals,strategies,tokens,calldata\n", number);
+            return EXIT_FAILURE;
+        }
+        const uint8_t *calldata = (const uint8_t *) line + consumed;
+
+        // the counts do not depend on the run, they are taken on the first one
+        hashes = 0;
+        addresses = 0;
+        for (unsigned long i = 0; i < repetitions; i++) {
+            uint64_t start = now_ns();
+            result = host_plugin_run(calldata,
+                                     size,
+                                     MAINNET_CHAIN_ID,
+                                     screens,
+                                     &count,
+                                     &position);
+            times[i] = now_ns() - start;
+            if (i == 0) {
+                metrics[METRIC_HASHES] = hashes;
+                metrics[METRIC_ADDRESSES] = addresses;
+            }
+        }
+        qsort(times, repetitions, sizeof(uint64_t), compare_u64);
+        metrics[METRIC_NS] = times[repetitions / 2];
+        metrics[METRIC_SCREENS] = result == HOST_OK ? count : 0;
+
+        selector = selector_index(calldata, size);
+        printf("%s,%lu,%lu,%lu,%zu,%llu,%llu,%llu,%llu,%s\n",
+               selector >= 0 ? SELECTOR_NAMES[selector] : "unknown",
+               withdrawals,
+               strategies,
+               tokens,
+               (size - SELECTOR_SIZE) / PARAMETER_LENGTH,
+               (unsigned long long) metrics[METRIC_HASHES],
+               (unsigned long long) metrics[METRIC_ADDRESSES],
+               (unsigned long long) metrics[METRIC_SCREENS],
+               (unsigned long long) metrics[METRIC_NS],
+               host_status_name(result));
+
+        if (result == HOST_OK && selector >= 0) {
+            curve_add(&curves[selector],
+                      (double) ((size - SELECTOR_SIZE) / PARAMETER_LENGTH),
+                      metrics);
+        }
+    }
+
+    for (int selector = 0; selector < SELECTOR_COUNT; selector++) {
+        if (curves[selector].count < 2) {
+            continue;
+        }
+        fprintf(stderr, "%s (%zu points):", SELECTOR_NAMES[selector], curves[selector].count);
+        for (int metric = 0; metric < METRIC_COUNT; metric++) {
+            double power = exponent(&curves[selector], metric);
+            bool super_linear = power > threshold;
+
+            fprintf(stderr,
+                    " %s ~ parameters^%.2f%s",
+                    METRIC_NAMES[metric],
+                    power,
+                    super_linear ? " (SUPER-LINEAR)" : "");
+            if (super_linear) {
+                status = EXIT_FAILURE;
+            }
+        }
+        fprintf(stderr, "\n");
+    }
+
+    free(line);
+    free(times);
+    free(screens);
+    for (int selector = 0; selector < SELECTOR_COUNT; selector++) {
+        free(curves[selector].parameters);
+        for (int metric = 0; metric < METRIC_COUNT; metric++) {
+            free(curves[selector].metrics[metric]);
+        }
+    }
+    return status;
+}
@@ -0,0 +1,406 @@
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "plugin.h"
+#include "host_plugin.h"
+
+// Pre-validation of a batch of transactions on the host, run with
+// `./build/validate [-j threads] [file]`.
+// Every line of the input (stdin by default) is a transaction: its hex calldata, or a JSON object
+// with a "calldata" string and an optional "chain_id" (Ethereum mainnet by default). Each one goes
+// through the whole plugin flow (see host_plugin.h), and one JSON line is written per input line,
+// in order: the screens the device would display, or the callback that rejected the transaction
+// along with the offset of the rejected parameter. The transactions are independent, so they are
+// spread across threads.
+
+#define BATCH_LINES 65536
+// lines taken at once by a thread
+#define CHUNK_LINES      256
+#define MAINNET_CHAIN_ID 1
+
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+} buffer_t;
+
+typedef struct {
+    uint32_t worker;  // worker whose output holds the result
+    size_t start;     // offset of the result in the output of the worker
+    size_t end;
+} result_t;
+
+typedef struct {
+    buffer_t output;
+    host_screen_t screens[HOST_MAX_SCREENS];
+    uint8_t *calldata;
+    size_t calldata_capacity;
+    uint64_t rejected;
+    uint64_t unknown;
+} worker_t;
+
+typedef struct {
+    const char *arena;     // lines of the batch, null terminated
+    const size_t *lines;   // offset of each line in `arena`
+    size_t count;          // number of lines in the batch
+    uint64_t first_line;   // number of the first line of the batch in the input
+    result_t *results;     // result of each line
+    worker_t *workers;     // one per thread
+    atomic_size_t next;    // next line to take
+} batch_t;
+
+typedef struct {
+    batch_t *batch;
+    uint32_t index;
+} worker_arg_t;
+
+static void reserve(buffer_t *buffer, size_t length) {
+    if (buffer->length + length <= buffer->capacity) {
+        return;
+    }
+    size_t capacity = buffer->capacity ? buffer->capacity : 4096;
+    while (capacity < buffer->length + length) {
+        capacity *= 2;
+    }
+    buffer->data = realloc(buffer->data, capacity);
+    if (buffer->data == NULL) {
+        perror("realloc");
+        exit(EXIT_FAILURE);
+    }
+    buffer->capacity = capacity;
+}
+
+static void append(buffer_t *buffer, const char *data, size_t length) {
+    reserve(buffer, length);
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+}
+
+static void append_str(buffer_t *buffer, const char *str) {
+    append(buffer, str, strlen(str));
+}
+
+static void append_json_string(buffer_t *buffer, const char *str) {
+    append(buffer, "\"", 1);
+    for (; *str != '\0'; str++) {
+        char escaped[8];
+        if (*str == '"' || *str == '\\') {
+            escaped[0] = '\\';
+            escaped[1] = *str;
+            append(buffer, escaped, 2);
+        } else if ((unsigned char) *str < 0x20) {
+            snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned char) *str);
+            append(buffer, escaped, 6);
+        } else {
+            append(buffer, str, 1);
+        }
+    }
+    append(buffer, "\"", 1);
+}
+
+static void append_number(buffer_t *buffer, uint64_t value) {
+    char number[24];
+    int length = snprintf(number, sizeof(number), "%llu", (unsigned long long) value);
+    append(buffer, number, (size_t) length);
+}
+
+/**
+ * @brief Decode hex calldata, with or without 0x prefix, into the buffer of a worker
+ *
+ * @param worker: worker decoding the calldata
+ * @param hex: hex digits
+ * @param length: number of hex digits
+ * @param size: set to the calldata size
+ *
+ * @returns false if the calldata is not valid hex
+ */
+static bool decode_calldata(worker_t *worker, const char *hex, size_t length, size_t *size) {
+    if (length / 2 > worker->calldata_capacity) {
+        worker->calldata_capacity = length / 2;
+        worker->calldata = realloc(worker->calldata, worker->calldata_capacity);
+        if (worker->calldata == NULL) {
+            perror("realloc");
+            exit(EXIT_FAILURE);
+        }
+    }
+    return host_decode_hex(hex, length, worker->calldata, size);
+}
+
+/**
+ * @brief Find the value of a key of a flat JSON object
+ *
+ * @param line: JSON object
+ * @param key: quoted key
+ *
+ * @returns first character of the value, NULL if the key is missing
+ */
+static const char *json_value(const char *line, const char *key) {
+    const char *value = strstr(line, key);
+    if (value == NULL) {
+        return NULL;
+    }
+    value += strlen(key);
+    while (*value == ' ' || *value == '\t') {
+        value++;
+    }
+    if (*value++ != ':') {
+        return NULL;
+    }
+    while (*value == ' ' || *value == '\t') {
+        value++;
+    }
+    return value;
+}
+
+/**
+ * @brief Read a transaction of the input
+ *
+ * @param worker: worker decoding the calldata
+ * @param line: hex calldata or JSON object
+ * @param size: set to the calldata size
+ * @param chain_id: set to the chain id of the transaction
+ *
+ * @returns error message, NULL if the transaction was read
+ */
+static const char *read_transaction(worker_t *worker,
+                                    const char *line,
+                                    size_t *size,
+                                    uint64_t *chain_id) {
+    const char *hex = line;
+    size_t length;
+
+    *chain_id = MAINNET_CHAIN_ID;
+    if (*line == '{') {
+        const char *value = json_value(line, "\"chain_id\"");
+        if (value != NULL) {
+            char *end;
+            bool quoted = (*value == '"');
+            *chain_id = strtoull(value + quoted, &end, 0);
+            if (end == value + quoted || (quoted && *end != '"')) {
+                return "invalid chain_id";
+            }
+        }
+        hex = json_value(line, "\"calldata\"");
+        if (hex == NULL || *hex++ != '"') {
+            return "missing calldata";
+        }
+        const char *end = strchr(hex, '"');
+        if (end == NULL) {
+            return "invalid calldata";
+        }
+        length = (size_t) (end - hex);
+    } else {
+        length = strlen(hex);
+    }
+    if (!decode_calldata(worker, hex, length, size)) {
+        return "invalid calldata";
+    }
+    return NULL;
+}
+
+/**
+ * @brief Run a transaction through the plugin and write its result
+ *
+ * @param worker: worker running the transaction
+ * @param size: calldata size
+ * @param chain_id: chain id of the transaction
+ *
+ * @returns false if the plugin rejected the transaction
+ */
+static bool run(worker_t *worker, size_t size, uint64_t chain_id) {
+    buffer_t *output = &worker->output;
+    size_t count;
+    size_t position;
+    bool unknown = false;
+    host_status_t status =
+        host_plugin_run(worker->calldata, size, chain_id, worker->screens, &count, &position);
+
+    if (status == HOST_INVALID_CALLDATA) {
+        append_str(output, ", \"status\": \"invalid\", \"error\": ");
+        append_str(output, "\"calldata is not a selector followed by 32-byte parameters\"}\n");
+        return false;
+    }
+    if (status != HOST_OK) {
+        append_str(output, ", \"status\": \"rejected\", \"callback\": \"");
+        append_str(output, host_status_name(status));
+        if (status == HOST_PROVIDE_PARAMETER) {
+            append_str(output, "\", \"offset\": ");
+            append_number(output, position);
+        } else if (status == HOST_QUERY_CONTRACT_UI) {
+            append_str(output, "\", \"screen\": ");
+            append_number(output, position);
+        } else {
+            append_str(output, "\"");
+        }
+        append_str(output, "}\n");
+        return false;
+    }
+
+    append_str(output, ", \"status\": \"ok\", \"screens\": [");
+    for (size_t i = 0; i < count; i++) {
+        unknown |= (strstr(worker->screens[i].msg, "UNKNOWN") != NULL);
+        append_str(output, (i == 0) ? "{\"title\": " : ", {\"title\": ");
+        append_json_string(output, worker->screens[i].title);
+        append_str(output, ", \"msg\": ");
+        append_json_string(output, worker->screens[i].msg);
+        append_str(output, "}");
+    }
+    append_str(output, unknown ? "], \"unknown\": true}\n" : "], \"unknown\": false}\n");
+    worker->unknown += unknown;
+    return true;
+}
+
+static void *work(void *arg) {
+    batch_t *batch = ((worker_arg_t *) arg)->batch;
+    uint32_t index = ((worker_arg_t *) arg)->index;
+    worker_t *worker = &batch->workers[index];
+
+    for (;;) {
+        size_t first = atomic_fetch_add(&batch->next, CHUNK_LINES);
+        if (first >= batch->count) {
+            return NULL;
+        }
+        size_t last = (first + CHUNK_LINES < batch->count) ? first + CHUNK_LINES : batch->count;
+        for (size_t i = first; i < last; i++) {
+            const char *line = batch->arena + batch->lines[i];
+            buffer_t *output = &worker->output;
+            size_t size;
+            uint64_t chain_id;
+
+            batch->results[i].worker = index;
+            batch->results[i].start = output->length;
+            append_str(output, "{\"line\": ");
+            append_number(output, batch->first_line + i);
+
+            const char *error = read_transaction(worker, line, &size, &chain_id);
+            if (error != NULL) {
+                append_str(output, ", \"status\": \"invalid\", \"error\": ");
+                append_json_string(output, error);
+                append_str(output, "}\n");
+                worker->rejected += 1;
+            } else {
+                append_str(output, ", \"chain_id\": ");
+                append_number(output, chain_id);
+                worker->rejected += !run(worker, size, chain_id);
+            }
+            batch->results[i].end = output->length;
+        }
+    }
+}
+
+/**
+ * @brief Process a batch of lines with every worker, then write the results in order
+ *
+ * @param batch: batch to process
+ * @param threads: number of worker threads
+ *
+ */
+static void process(batch_t *batch, uint32_t threads) {
+    pthread_t ids[threads];
+    worker_arg_t args[threads];
+
+    atomic_store(&batch->next, 0);
+    for (uint32_t i = 0; i < threads; i++) {
+        batch->workers[i].output.length = 0;
+        args[i] = (worker_arg_t){batch, i};
+        if (pthread_create(&ids[i], NULL, work, &args[i]) != 0) {
+            perror("pthread_create");
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (uint32_t i = 0; i < threads; i++) {
+        pthread_join(ids[i], NULL);
+    }
+    for (size_t i = 0; i < batch->count; i++) {
+        const result_t *result = &batch->results[i];
+        fwrite(batch->workers[result->worker].output.data + result->start,
+               1,
+               result->end - result->start,
+               stdout);
+    }
+}
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+
+int main(int argc, char **argv) {
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t threads = (online > 0) ? (uint32_t) online : 1;
+    FILE *input = stdin;
+    int option;
+
+    while ((option = getopt(argc, argv, "j:")) != -1) {
+        if (option != 'j' || atoi(optarg) <= 0) {
+            fprintf(stderr, "Usage: %s [-j threads] [file]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+        threads = (uint32_t) atoi(optarg);
+    }
+    if (optind < argc && (input = fopen(argv[optind], "r")) == NULL) {
+        perror(argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    static size_t lines[BATCH_LINES];
+    static result_t results[BATCH_LINES];
+    worker_t *workers = calloc(threads, sizeof(*workers));
+    buffer_t arena = {0};
+    batch_t batch = {.lines = lines, .results = results, .workers = workers, .first_line = 1};
+    char *line = NULL;
+    size_t capacity = 0;
+    ssize_t length;
+    uint64_t total = 0;
+    uint64_t start = now_ns();
+
+    if (workers == NULL) {
+        perror("calloc");
+        return EXIT_FAILURE;
+    }
+    while ((length = getline(&line, &capacity, input)) >= 0) {
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+            length--;
+        }
+        lines[batch.count++] = arena.length;
+        append(&arena, line, (size_t) length);
+        append(&arena, "", 1);
+        if (batch.count == BATCH_LINES) {
+            batch.arena = arena.data;
+            process(&batch, threads);
+            total += batch.count;
+            batch.first_line += batch.count;
+            batch.count = 0;
+            arena.length = 0;
+        }
+    }
+    if (batch.count > 0) {
+        batch.arena = arena.data;
+        process(&batch, threads);
+        total += batch.count;
+    }
+    fflush(stdout);
+
+    uint64_t rejected = 0;
+    uint64_t unknown = 0;
+    for (uint32_t i = 0; i < threads; i++) {
+        rejected += workers[i].rejected;
+        unknown += workers[i].unknown;
+    }
+    double seconds = (double) (now_ns() - start) / 1e9;
+    fprintf(stderr,
+            "%llu transactions, %llu rejected, %llu with unknown strategies, "
+            "%.0f transactions per minute on %u threads\n",
+            (unsigned long long) total,
+            (unsigned long long) rejected,
+            (unsigned long long) unknown,
+            seconds > 0 ? total * 60 / seconds : 0.0,
+            threads);
+    return (rejected == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
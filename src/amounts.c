@@ -0,0 +1,172 @@
+#include "plugin.h"
+
+/**
+ * @brief Get the number of significant bytes of a big endian amount
+ *
+ * @param value: big endian amount
+ * @param size: bytes of the amount
+ *
+ * @returns size of the amount without its leading zero bytes, 0 for 0
+ */
+uint8_t amount_size(const uint8_t *value, uint8_t size) {
+    uint8_t skip = 0;
+
+    while (skip < size && value[skip] == 0) {
+        skip++;
+    }
+    return size - skip;
+}
+
+/**
+ * @brief Get the number of bytes of an entry of a list of amounts
+ *
+ * @param list: list of amounts
+ * @param offset: offset of the entry in the list
+ *
+ * @returns size of the entry
+ */
+static uint8_t entry_size(const uint8_t *list, uint8_t offset) {
+    uint8_t size = list[offset + 1];
+    return AMOUNT_HEADER_LENGTH + ((size == AMOUNT_NONE) ? 0 : size);
+}
+
+/**
+ * @brief Get an entry of a list of amounts by rank
+ *
+ * @param list: list of amounts
+ * @param length: bytes of the list used
+ * @param index: rank of the entry
+ *
+ * @returns offset of the entry in the list, `length` if there is no such entry
+ */
+uint8_t amounts_entry(const uint8_t *list, uint8_t length, uint8_t index) {
+    uint8_t offset = 0;
+
+    while (offset < length && index-- > 0) {
+        offset += entry_size(list, offset);
+    }
+    return offset;
+}
+
+/**
+ * @brief Get the number of entries of a list of amounts
+ *
+ * @param list: list of amounts
+ * @param length: bytes of the list used
+ *
+ * @returns number of entries
+ */
+uint8_t amounts_count(const uint8_t *list, uint8_t length) {
+    uint8_t count = 0;
+
+    for (uint8_t offset = 0; offset < length; offset += entry_size(list, offset)) {
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Find the first entry of a registry index in a list of amounts
+ *
+ * @param list: list of amounts
+ * @param length: bytes of the list used
+ * @param index: registry index of the entry
+ *
+ * @returns offset of the entry in the list, `length` if there is none
+ */
+uint8_t amounts_find(const uint8_t *list, uint8_t length, uint8_t index) {
+    uint8_t offset = 0;
+
+    while (offset < length && list[offset] != index) {
+        offset += entry_size(list, offset);
+    }
+    return offset;
+}
+
+/**
+ * @brief Append an entry to a list of amounts
+ *
+ * @param list: list of amounts
+ * @param length: bytes of the list used, updated
+ * @param capacity: bytes of the list
+ * @param index: registry index of the entry
+ * @param value: big endian amount, NULL for an entry without amount
+ * @param size: bytes of the amount
+ *
+ * @returns false if the entry does not fit in the list
+ */
+bool amounts_append(uint8_t *list,
+                    uint8_t *length,
+                    uint8_t capacity,
+                    uint8_t index,
+                    const uint8_t *value,
+                    uint8_t size) {
+    uint8_t used = 0;
+
+    if (value != NULL) {
+        used = amount_size(value, size);
+        value += size - used;
+    }
+    if (*length + AMOUNT_HEADER_LENGTH + used > capacity) {
+        return false;
+    }
+    list[*length] = index;
+    list[*length + 1] = (value != NULL) ? used : AMOUNT_NONE;
+    if (value != NULL) {
+        memcpy(list + *length + AMOUNT_HEADER_LENGTH, value, used);
+    }
+    *length += AMOUNT_HEADER_LENGTH + used;
+    return true;
+}
+
+/**
+ * @brief Replace the amount of an entry of a list of amounts, moving the next entries
+ *
+ * @param list: list of amounts
+ * @param length: bytes of the list used, updated
+ * @param capacity: bytes of the list
+ * @param offset: offset of the entry in the list
+ * @param value: big endian amount, NULL to drop the amount of the entry
+ * @param size: bytes of the amount
+ *
+ * @returns false if the amount does not fit in the list, the entry is left unchanged
+ */
+bool amounts_set(uint8_t *list,
+                 uint8_t *length,
+                 uint8_t capacity,
+                 uint8_t offset,
+                 const uint8_t *value,
+                 uint8_t size) {
+    uint8_t used = 0;
+
+    if (value != NULL) {
+        used = amount_size(value, size);
+        value += size - used;
+    }
+    uint8_t old_end = offset + entry_size(list, offset);
+    uint8_t new_end = offset + AMOUNT_HEADER_LENGTH + used;
+    if (*length - old_end + new_end > capacity) {
+        return false;
+    }
+    memmove(list + new_end, list + old_end, *length - old_end);
+    *length = *length - old_end + new_end;
+    list[offset + 1] = (value != NULL) ? used : AMOUNT_NONE;
+    if (value != NULL) {
+        memcpy(list + offset + AMOUNT_HEADER_LENGTH, value, used);
+    }
+    return true;
+}
+
+/**
+ * @brief Get an amount of a list of amounts
+ *
+ * @param list: list of amounts
+ * @param offset: offset of the entry in the list
+ * @param size: set to the bytes of the amount
+ *
+ * @returns big endian amount without its leading zero bytes, NULL if the entry has none
+ */
+const uint8_t *amounts_value(const uint8_t *list, uint8_t offset, uint8_t *size) {
+    *size = list[offset + 1];
+    return (*size == AMOUNT_NONE) ? NULL : list + offset + AMOUNT_HEADER_LENGTH;
+}
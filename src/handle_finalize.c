@@ -1,35 +1,111 @@
 #include "plugin.h"
 
-void handle_finalize(ethPluginFinalize_t *msg) {
-    context_t *context = (context_t *) msg->pluginContext;
+/**
+ * @brief Finalize a transaction whose screens are all known from its selector
+ *
+ * @param context: context of the plugin
+ * @param screens: set to the number of screens added to the base ones
+ *
+ * @returns true, the parser already checked the transaction
+ */
+static bool finalize_fixed(const context_t *context, uint8_t *screens) {
+    (void) context;
+    *screens = 0;
+    return true;
+}
 
-    msg->uiType = ETH_UI_TYPE_GENERIC;
+/**
+ * @brief Finalize a queueWithdrawals transaction, one screen per page of strategies
+ *
+ * @param context: context of the plugin
+ * @param screens: set to the number of screens added to the base ones
+ *
+ * @returns true
+ */
+static bool finalize_withdrawals(const context_t *context, uint8_t *screens) {
+    *screens = strategies_screens(&context->tx.queue_withdrawal.strategies,
+                                  context_registry(context));
+    return true;
+}
 
-    // The total number of screen you will need.
+/**
+ * @brief Finalize a completeQueuedWithdrawals transaction, one screen per page of strategies
+ *
+ * @param context: context of the plugin
+ * @param screens: set to the number of screens added to the base ones
+ *
+ * @returns false if the tokens do not match the strategies
+ */
+static bool finalize_completed_withdrawals(const context_t *context, uint8_t *screens) {
+    const complete_queued_withdrawals_t *tx = &context->tx.complete_queued_withdrawals;
+    // each token must be the token of the strategy at the same position of its withdrawal,
+    // unknown ones included. The strategies of a withdrawal are no longer known when its tokens
+    // array is parsed, so an empty one can not be left out of the comparison: the batch is only
+    // accepted if all its tokens arrays are empty, nothing is received as tokens, or none is.
+    if (tx->tokens_withdrawals > 0 && tx->tokens_withdrawals != tx->withdrawals_count) {
+        TRACE(TRACE_TOKENS_PARTIAL, 0, tx->tokens_withdrawals, tx->withdrawals_count);
+        return false;
+    }
+    if (tx->tokens_withdrawals > 0 && tx->tokens_digest != tx->strategies_digest) {
+        TRACE(TRACE_TOKENS_MISMATCH, 0, tx->tokens_withdrawals, tx->strategies.count);
+        return false;
+    }
+    *screens = strategies_screens(&tx->strategies, context_registry(context));
+    return true;
+}
+
+/**
+ * @brief Finalize a processClaim transaction, one screen per token leaf
+ *
+ * @param context: context of the plugin
+ * @param screens: set to the number of screens added to the base ones
+ *
+ * @returns true
+ */
+static bool finalize_claim(const context_t *context, uint8_t *screens) {
+    *screens = rewards_screens(&context->tx.process_claim);
+    return true;
+}
+
+#define TO_FINALIZE_CASE(name, selector, label, screens, finalize, handler) \
+    case name:                                                              \
+        return finalize(context, extra_screens);
+
+/**
+ * @brief Check the parsed transaction of a selector and count its variable screens
+ *
+ * @param context: context of the plugin
+ * @param extra_screens: set to the number of screens added to the base ones
+ *
+ * @returns false if the transaction is not valid
+ */
+static bool finalize_selector(const context_t *context, uint8_t *extra_screens) {
     switch (context->selectorIndex) {
-        case DEPOSIT_INTO_STRATEGY:
-            msg->numScreens = 2;
-            break;
-        case UNDELEGATE:
-            msg->numScreens = 1;
-            break;
-        case DELEGATE_TO:
-            msg->numScreens = 1;
-            break;
-        case QUEUE_WITHDRAWAL_PARAMS:
-            // withdrawer
-            msg->numScreens = 1;
-            msg->numScreens += context->tx.queue_withdrawal.strategies_count;
-            break;
-        case COMPLETE_QUEUED_WITHDRAWALS:
-            // withdrawer
-            msg->numScreens = 1;
-            msg->numScreens += context->tx.complete_queued_withdrawals.strategies_count;
-            break;
+        SELECTORS_LIST(TO_FINALIZE_CASE)
         default:
-            msg->result = ETH_PLUGIN_RESULT_ERROR;
-            return;
+            TRACE(TRACE_UNSUPPORTED_SELECTOR, 0, context->selectorIndex, 0);
+            return false;
     }
+}
+
+void handle_finalize(ethPluginFinalize_t *msg) {
+    context_t *context = (context_t *) msg->pluginContext;
+    uint8_t screens;
 
+    // Every parameter and offset must have been parsed.
+    if (context->go_to_offset) {
+        TRACE(TRACE_CALLDATA_ENDS_BEFORE_OFFSET, 0, 0, context->parser.offset);
+        msg->result = ETH_PLUGIN_RESULT_ERROR;
+        return;
+    }
+    if (!parser_finish(&context->parser) || !finalize_selector(context, &screens)) {
+        msg->result = ETH_PLUGIN_RESULT_ERROR;
+        return;
+    }
+
+    msg->uiType = ETH_UI_TYPE_GENERIC;
+
+    // The total number of screen you will need.
+    msg->numScreens = SELECTOR_SCREENS[context->selectorIndex] + screens;
     msg->result = ETH_PLUGIN_RESULT_OK;
 }
@@ -1,6 +1,52 @@
 #include "plugin_utils.h"
 #include "plugin.h"
 
+/**
+ * @brief Find the strategy registry of a chain
+ *
+ * @param chain_id: chain id of the transaction, big endian
+ *
+ * @returns index in REGISTRIES, the empty registry for other chains
+ */
+static uint8_t find_registry(const txInt256_t *chain_id) {
+    if (chain_id->length > sizeof(uint64_t)) {
+        return REGISTRIES_COUNT;
+    }
+    uint64_t id = u64_from_BE(chain_id->value, chain_id->length);
+    uint8_t index = 0;
+    while (index < REGISTRIES_COUNT && REGISTRIES[index].chain_id != id) {
+        index++;
+    }
+    return index;
+}
+
+/**
+ * @brief Find a selector of the plugin
+ *
+ * @param selector: selector of the transaction
+ * @param index: set to the selector_t of the selector
+ *
+ * @returns false if the plugin does not support the selector
+ */
+static bool find_selector_index(uint32_t selector, uint8_t *index) {
+    // SELECTORS is sorted by value
+    uint8_t low = 0;
+    uint8_t high = SELECTOR_COUNT;
+    while (low < high) {
+        uint8_t middle = low + (high - low) / 2;
+        if (SELECTORS[middle] == selector) {
+            *index = middle;
+            return true;
+        }
+        if (SELECTORS[middle] < selector) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return false;
+}
+
 // Called once to init.
 void handle_init_contract(ethPluginInitContract_t *msg) {
     // Make sure we are running a compatible version.
@@ -13,7 +59,7 @@ void handle_init_contract(ethPluginInitContract_t *msg) {
     // Double check that the `context_t` struct is not bigger than the maximum size (defined by
     // `msg->pluginContextLength`).
     if (msg->pluginContextLength < sizeof(context_t)) {
-        PRINTF("Plugin parameters structure is bigger than allowed size\n");
+        TRACE(TRACE_CONTEXT_TOO_SMALL, 0, 0, msg->pluginContextLength);
         msg->result = ETH_PLUGIN_RESULT_ERROR;
         return;
     }
@@ -23,43 +69,38 @@ void handle_init_contract(ethPluginInitContract_t *msg) {
     // Initialize the context (to 0).
     memset(context, 0, sizeof(*context));
 
-    size_t index;
-    if (!find_selector(U4BE(msg->selector, 0), SELECTORS, SELECTOR_COUNT, &index)) {
-        PRINTF("Error: selector not found!\n");
+    uint8_t index;
+    if (!find_selector_index(U4BE(msg->selector, 0), &index)) {
+        TRACE(TRACE_UNKNOWN_SELECTOR, 0, 0, U4BE(msg->selector, 0));
         msg->result = ETH_PLUGIN_RESULT_UNAVAILABLE;
         return;
     }
+    // selectorIndex is wide enough for SELECTOR_COUNT, see plugin.h
     context->selectorIndex = index;
-    // check for overflow
-    if ((size_t) context->selectorIndex != index) {
-        PRINTF("Error: overflow detected on selector index!\n");
+
+    // The calldata must hold the parameters of the selector, the array lengths are then checked
+    // against its size as soon as they are parsed.
+    if (!parser_check_size(PARSER_ROOTS[index], msg->dataSize)) {
+        TRACE(TRACE_UNEXPECTED_CALLDATA_SIZE, 0, 0, msg->dataSize);
         msg->result = ETH_PLUGIN_RESULT_ERROR;
         return;
     }
+    context->size = msg->dataSize;
 
-    // Set `next_param` to be the first field we expect to parse.
-    switch (context->selectorIndex) {
-        case DEPOSIT_INTO_STRATEGY:
-            context->next_param = STRATEGY;
-            break;
-        case UNDELEGATE:
-            context->next_param = STAKER;
-            break;
-        case DELEGATE_TO:
-            context->next_param = OPERATOR;
-            break;
-        case QUEUE_WITHDRAWAL_PARAMS:
-            context->next_param = DATA_OFFSET;
-            break;
-        case COMPLETE_QUEUED_WITHDRAWALS:
-            context->next_param = WITHDRAWALS_OFFSET;
-            break;
-        default:
-            PRINTF("Missing selectorIndex: %d\n", context->selectorIndex);
-            msg->result = ETH_PLUGIN_RESULT_ERROR;
-            return;
+    // Lookups only use the registry of the chain of the transaction.
+    const txInt256_t *chain_id = &msg->pluginSharedRO->txContent->chainID;
+    context->registry = find_registry(chain_id);
+    if (context->registry == REGISTRIES_COUNT) {
+        TRACE(TRACE_NO_REGISTRY,
+              0,
+              chain_id->length,
+              chain_id->length <= sizeof(uint32_t) ? u64_from_BE(chain_id->value, chain_id->length)
+                                                   : 0);
     }
 
+    // Start parsing the parameters of the selector.
+    parser_init(&context->parser, PARSER_ROOTS[context->selectorIndex]);
+
     // Return valid status.
     msg->result = ETH_PLUGIN_RESULT_OK;
 }
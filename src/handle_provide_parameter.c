@@ -1,54 +1,72 @@
 #include "plugin.h"
 
 /**
- * @brief Compare two addresses
+ * @brief Get the address held in the last 20 bytes of a 32-byte parameter
  *
- * @param a: first address
- * @param b: second address
+ * @param parameter: calldata parameter holding an address
  *
- * @return true if the addresses are the same
+ * @return pointer to the binary address inside the parameter
  */
-bool compare_addresses(const char a[ADDRESS_STR_LEN], const char b[ADDRESS_STR_LEN]) {
-    for (size_t i = 0; i < ADDRESS_STR_LEN; i += 1) {
-        if (tolower((unsigned char) a[i]) != tolower((unsigned char) b[i])) {
-            return false;
-        }
-    }
-    return true;
+static inline const uint8_t *address_from_parameter(const uint8_t *parameter) {
+    return parameter + PARAMETER_LENGTH - ADDRESS_LENGTH;
 }
 
 /**
- * @brief If address is a known erc20 token, update display context with its name
- * otherwise set it to unkwown (UNKNOWN_ERC20)
+ * @brief Binary search an address in a registry table
  *
- * @param address: address to compare
+ * @param addresses: registry table, sorted by address
+ * @param count: number of addresses in the table
+ * @param address: binary address to look for
  *
- * @returns index of the erc20 in the context or UNKNOWN_ERC20 if not found
+ * @returns index of the address in the table or `count` if not found
  */
-uint8_t decode_token(const char address[ADDRESS_STR_LEN]) {
-    for (size_t i = 0; i < STRATEGIES_COUNT; i++) {
-        if (compare_addresses(address, token_addresses[i])) {
-            return i;
+static uint8_t find_address(const uint8_t (*addresses)[ADDRESS_LENGTH],
+                            uint8_t count,
+                            const uint8_t address[ADDRESS_LENGTH]) {
+    uint8_t low = 0;
+    uint8_t high = count;
+
+    while (low < high) {
+        uint8_t middle = low + (high - low) / 2;
+        int order = memcmp(address, addresses[middle], ADDRESS_LENGTH);
+        if (order == 0) {
+            return middle;
+        }
+        if (order < 0) {
+            high = middle;
+        } else {
+            low = middle + 1;
         }
     }
-    return UNKNOWN_TOKEN;
+    return count;
 }
 
 /**
- * @brief If address is a known strategy, update display context with its name
- * otherwise set it to unkwown (UNKNOWN_STRATEGY)
+ * @brief If address is a known erc20 token, get the registry index of its strategy, whose ticker
+ * is displayed, otherwise unknown (UNKNOWN_TOKEN)
  *
- * @param address: address to compare
+ * @param registry: registry of the chain of the transaction
+ * @param address: binary address to compare
  *
- * @returns index of the erc20 in the context or UNKNOWN_STRATEGY if not found
+ * @returns registry index of the strategy of the erc20 or UNKNOWN_TOKEN if not found
  */
-uint8_t decode_strategy(const char address[ADDRESS_STR_LEN]) {
-    for (size_t i = 0; i < STRATEGIES_COUNT; i++) {
-        if (compare_addresses(address, strategy_addresses[i])) {
-            return i;
-        }
-    }
-    return UNKNOWN_STRATEGY;
+uint8_t decode_token(const registry_t *registry, const uint8_t address[ADDRESS_LENGTH]) {
+    uint8_t index = find_address(registry->token_addresses, registry->count, address);
+    return (index < registry->count) ? registry->token_strategies[index] : UNKNOWN_TOKEN;
+}
+
+/**
+ * @brief If address is a known strategy, get its registry index, otherwise unknown
+ * (UNKNOWN_STRATEGY)
+ *
+ * @param registry: registry of the chain of the transaction
+ * @param address: binary address to compare
+ *
+ * @returns registry index of the strategy or UNKNOWN_STRATEGY if not found
+ */
+uint8_t decode_strategy(const registry_t *registry, const uint8_t address[ADDRESS_LENGTH]) {
+    uint8_t index = find_address(registry->strategy_addresses, registry->count, address);
+    return (index < registry->count) ? index : UNKNOWN_STRATEGY;
 }
 
 /**
@@ -56,39 +74,28 @@ uint8_t decode_strategy(const char address[ADDRESS_STR_LEN]) {
  *
  * @param msg: message containing the parameter
  * @param context: context to update
+ * @param field: parameter to capture
  *
  */
-static void handle_deposit_into_strategy(ethPluginProvideParameter_t *msg, context_t *context) {
-    uint8_t buffer[ADDRESS_LENGTH] = {0};
-    char address[ADDRESS_STR_LEN] = {0};
-
-    switch (context->next_param) {
+static void handle_deposit_into_strategy(ethPluginProvideParameter_t *msg,
+                                         context_t *context,
+                                         uint8_t field) {
+    switch (field) {
         case STRATEGY:
-            copy_address(buffer, msg->parameter, sizeof(buffer));
-            if (!getEthDisplayableAddress(buffer, address, sizeof(address), 0)) {
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-            context->tx.deposit_into_strategy.strategy = decode_strategy(address);
-            context->next_param = TOKEN;
+            context->tx.deposit_into_strategy.strategy =
+                decode_strategy(context_registry(context), address_from_parameter(msg->parameter));
             break;
         case TOKEN:
-            copy_address(buffer, msg->parameter, sizeof(buffer));
-            if (!getEthDisplayableAddress(buffer, address, sizeof(address), 0)) {
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-            context->tx.deposit_into_strategy.token = decode_token(address);
-            context->next_param = AMOUNT;
+            context->tx.deposit_into_strategy.token =
+                decode_token(context_registry(context), address_from_parameter(msg->parameter));
             break;
         case AMOUNT:
-            copy_parameter(context->tx.deposit_into_strategy.amount.value,
+            copy_parameter(context->tx.deposit_into_strategy.amount,
                            msg->parameter,
-                           sizeof(context->tx.deposit_into_strategy.amount.value));
-            context->next_param = UNEXPECTED_PARAMETER;
+                           sizeof(context->tx.deposit_into_strategy.amount));
             break;
         default:
-            PRINTF("Param not supported: %d\n", context->next_param);
+            TRACE(TRACE_UNSUPPORTED_FIELD, msg->parameterOffset, field, 0);
             msg->result = ETH_PLUGIN_RESULT_ERROR;
             break;
     }
@@ -99,896 +106,342 @@ static void handle_deposit_into_strategy(ethPluginProvideParameter_t *msg, conte
  *
  * @param msg: message containing the parameter
  * @param context: context to update
+ * @param field: parameter to capture
  *
  */
-static void handle_undelegate(ethPluginProvideParameter_t *msg, context_t *context) {
-    switch (context->next_param) {
+static void handle_undelegate(ethPluginProvideParameter_t *msg, context_t *context, uint8_t field) {
+    switch (field) {
         case STAKER:
             copy_address(context->tx.undelegate.staker.value,
                          msg->parameter,
                          sizeof(context->tx.undelegate.staker.value));
-            context->next_param = UNEXPECTED_PARAMETER;
             break;
         default:
-            PRINTF("Param not supported: %d\n", context->next_param);
+            TRACE(TRACE_UNSUPPORTED_FIELD, msg->parameterOffset, field, 0);
             msg->result = ETH_PLUGIN_RESULT_ERROR;
             break;
     }
 }
 
 /**
- * @brief Handle the parameters for the delegate selector
+ * @brief Handle the parameters for the delegateTo selector
  *
  * @param msg: message containing the parameter
  * @param context: context to update
+ * @param field: parameter to capture
  *
  */
-static void handle_delegate(ethPluginProvideParameter_t *msg, context_t *context) {
-    uint16_t offset = 0;
-    switch (context->next_param) {
+static void handle_delegate_to(ethPluginProvideParameter_t *msg,
+                               context_t *context,
+                               uint8_t field) {
+    switch (field) {
         case OPERATOR:
             copy_address(context->tx.delegate_to.operator.value,
                          msg->parameter,
                          sizeof(context->tx.delegate_to.operator.value));
-            context->next_param = SIGNATURE_OFFSET;
-            break;
-        case SIGNATURE_OFFSET:
-            if (!U2BE_from_parameter(msg->parameter, &offset) || offset != PARAMETER_LENGTH * 3) {
-                // OFFSET bigger than this offset + signature salt
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-            context->next_param = APPROVER_SALT;
-            break;
-        case APPROVER_SALT:
-            context->next_param = SIGNATURE_SIG_OFFSET;
-            break;
-        case SIGNATURE_SIG_OFFSET:
-            if (!U2BE_from_parameter(msg->parameter, &offset) || offset != PARAMETER_LENGTH * 2) {
-                // OFFSET bigger than this offset + expericy
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-            context->next_param = SIGNATURE_EXPIRACY;
-            break;
-        case SIGNATURE_EXPIRACY:
-            context->next_param = SIGNATURE_LENGTH;
-            break;
-        case SIGNATURE_LENGTH:
-            if (!U2BE_from_parameter(msg->parameter,
-                                     &context->tx.delegate_to.signature_packet_count)) {
-                msg->result = ETH_PLUGIN_RESULT_UNSUCCESSFUL;
-            }
-            if (context->tx.delegate_to.signature_packet_count == 0) {
-                context->next_param = NONE;
-            } else {
-                context->next_param = SIGNATURE_PACKETS;
-            }
-            break;
-        case SIGNATURE_PACKETS:
-            context->tx.delegate_to.signature_packet_count -= 1;
-            if (context->tx.delegate_to.signature_packet_count == 0) {
-                context->next_param = NONE;
-            }
-            break;
-        case NONE:
             break;
         default:
-            PRINTF("Param not supported: %d\n", context->next_param);
+            TRACE(TRACE_UNSUPPORTED_FIELD, msg->parameterOffset, field, 0);
             msg->result = ETH_PLUGIN_RESULT_ERROR;
             break;
     }
 }
 
 /**
- * @brief Handle the parameters for the queuedWithdrawal selector
+ * @brief Handle the strategies and shares arrays lengths and the shares of a withdrawal, shared
+ * by queueWithdrawals and completeQueuedWithdrawals
  *
  * @param msg: message containing the parameter
- * @param context: context to update
+ * @param strategies: strategies of the batch
+ * @param field: parameter to capture
  *
  */
-static void handle_queue_withdrawal(ethPluginProvideParameter_t *msg, context_t *context) {
-    queue_withdrawal_t *tx = &context->tx.queue_withdrawal;
-    switch (context->next_param) {
-        case DATA_OFFSET: {  // Data offset to beggin of the withdrawals tupple
-            uint16_t offset = 0;
-            if (!U2BE_from_parameter(msg->parameter, &offset) || offset != PARAMETER_LENGTH) {
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-            context->next_param = WITHDRAWALS_SIZE;
-            break;
-        }
-        case WITHDRAWALS_SIZE:  // Get size of tupple
-            if (!U2BE_from_parameter(msg->parameter, &tx->queued_withdrawals_count)) {
-                msg->result = ETH_PLUGIN_RESULT_UNSUCCESSFUL;
-            }
-            tx->current_item_count = tx->queued_withdrawals_count;
-            context->next_param = WITHDRAWALS_ITEM_OFFSET;
-            break;
-        case WITHDRAWALS_ITEM_OFFSET: {
-            // We have limited size on the context and can't store all the offset values
-            // of the queuedWithdrawal structs. So we compute their checksum and expect to
-            // be able to recompute it using the offset of the parsed structures later.
-            // _preview will be equal to _value at the end of the parsing if everything is fine
-            // Idea taken from Kiln plugin
-            uint16_t offset = 0;
-            if (!U2BE_from_parameter(msg->parameter, &offset)) {
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-
-            checksum_offset_params_t h_params;
-            memset(&h_params, 0, sizeof(h_params));
-            memcpy(&h_params.prev_checksum,
-                   &(tx->qwithdrawals_offsets_checksum_preview),
-                   sizeof(h_params.prev_checksum));
+static void handle_shares(ethPluginProvideParameter_t *msg,
+                          strategies_t *strategies,
+                          uint8_t field) {
+    uint16_t length;
 
-            // we hash the previous checksum with the offset of the beginning of the structure.
-            // the offset we parse is actually after SELECTOR + the 2 above param so we add them to
-            // it.
-            h_params.new_offset = offset + SELECTOR_SIZE + PARAMETER_LENGTH * 2;
-
-            if (cx_keccak_256_hash((void *) &h_params,
-                                   sizeof(h_params),
-                                   tx->qwithdrawals_offsets_checksum_preview) != CX_OK) {
-                PRINTF("unable to compute keccak hash\n");
+    switch (field) {
+        case STRATEGIES_SIZE:
+            if (!U2BE_from_parameter(msg->parameter, &length) ||
+                !strategies_start_withdrawal(strategies, length)) {
                 msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-            // we skip all the queuewithdrawal structs offsets
-            PRINTF("CURRENT ITEM COUNT: %d\n", tx->current_item_count);
-            if (tx->current_item_count > 0) {
-                tx->current_item_count -= 1;
-            }
-
-            if (tx->current_item_count == 0) {
-                context->next_param = STRATEGY_OFFSET;
             }
             break;
-        }
-        case STRATEGY_OFFSET: {
-            uint16_t offset = 0;
-            if (!U2BE_from_parameter(msg->parameter, &offset)) {
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            };
-            // here we are at the beginning of the queuedWithdrawal struct, so we want
-            // to compute the offset of the struct we're at for the queuedWithdrawal struct array
-            // offsets checksum
-
-            checksum_offset_params_t h_params;
-            memset(&h_params, 0, sizeof(h_params));
-            memcpy(&h_params.prev_checksum,
-                   &(tx->qwithdrawals_offsets_checksum_value),
-                   sizeof(h_params.prev_checksum));
-            h_params.new_offset = msg->parameterOffset;
-
-            if (cx_keccak_256_hash((void *) &h_params,
-                                   sizeof(h_params),
-                                   tx->qwithdrawals_offsets_checksum_value) != CX_OK) {
-                PRINTF("unable to compute keccak hash\n");
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-
-            if (tx->queued_withdrawals_count == 1) {
-                // if we are on the last item of the array of queuedWithdrawal struct
-                // we can check the checksum
-                if (memcmp(tx->qwithdrawals_offsets_checksum_preview,
-                           tx->qwithdrawals_offsets_checksum_value,
-                           sizeof(tx->qwithdrawals_offsets_checksum_preview)) != 0) {
-                    PRINTF("Checksums do not match\n");
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-            }
-
-            if (offset != PARAMETER_LENGTH * 3) {
-                // valid offset should only skip this + shares_offset + withdrawer
-                PRINTF("Unexpected parameter offset %d != %d\n", offset, PARAMETER_LENGTH * 3);
+        case SHARES_SIZE:
+            if (!U2BE_from_parameter(msg->parameter, &length) ||
+                !strategies_check_shares_length(strategies, length)) {
                 msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
             }
-            context->next_param = SHARES_OFFSET;
             break;
-        }
-        case SHARES_OFFSET:
-            // we can only check this value once we know strategies array length
-            if (!U2BE_from_parameter(msg->parameter, &tx->shares_array_offset)) {
+        case SHARE:
+            if (!strategies_add_share(strategies, msg->parameter)) {
                 msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
             }
-
-            context->next_param = WITHDRAWER;
             break;
-        case WITHDRAWER: {
-            {
-                uint8_t buffer[ADDRESS_LENGTH];
-                copy_address(buffer, msg->parameter, sizeof(buffer));
-                char address_buffer[ADDRESS_STR_LEN];
-                if (!getEthDisplayableAddress(buffer, address_buffer, sizeof(address_buffer), 0)) {
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-                // we only support same withdrawer accross all the withdrawals
-                if (tx->withdrawer[0] == '\0') {
-                    memcpy(tx->withdrawer, address_buffer, sizeof(tx->withdrawer));
-                } else if (strcmp(tx->withdrawer, address_buffer) != 0) {
-                    PRINTF("Unexpected withdrawer address, %s != expected %s\n",
-                           msg->parameter,
-                           tx->withdrawer);
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-            }
-            context->next_param = STRATEGY_SIZE;
+        default:
+            TRACE(TRACE_UNSUPPORTED_FIELD, msg->parameterOffset, field, 0);
+            msg->result = ETH_PLUGIN_RESULT_ERROR;
             break;
-        }
-        case STRATEGY_SIZE: {
-            if (!U2BE_from_parameter(msg->parameter, &tx->current_item_count)) {
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            };
-
-            {  // check that the shares array offset is correct
-                // -- 1. we skip shares_offset + withdrawer + strategies_length
-                uint16_t should_be = PARAMETER_LENGTH * 3
-                                     // -- 2. we skip the strategies array length
-                                     + PARAMETER_LENGTH + PARAMETER_LENGTH * tx->current_item_count;
-
-                if (tx->shares_array_offset != should_be) {
-                    PRINTF("Unexpected parameter offset %d != %d\n",
-                           tx->shares_array_offset,
-                           should_be);
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-            }
+    }
+}
 
-            if (tx->current_item_count == 0) {
-                // if no strategies we go to the shares array
-                context->next_param = SHARES_SIZE;
-            } else {
-                context->next_param = STRATEGY;
-            }
-            break;
-        }
+/**
+ * @brief Handle the parameters for the queueWithdrawals selector
+ *
+ * @param msg: message containing the parameter
+ * @param context: context to update
+ * @param field: parameter to capture
+ *
+ */
+static void handle_queue_withdrawal(ethPluginProvideParameter_t *msg,
+                                    context_t *context,
+                                    uint8_t field) {
+    queue_withdrawal_t *tx = &context->tx.queue_withdrawal;
 
+    switch (field) {
         case STRATEGY: {
             // get strategy we need to display
-            {
-                uint8_t buffer[ADDRESS_LENGTH];
-                copy_address(buffer, msg->parameter, sizeof(buffer));
-                char address_buffer[ADDRESS_STR_LEN];
-                if (!getEthDisplayableAddress(buffer, address_buffer, sizeof(address_buffer), 0)) {
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-
-                uint8_t strategy_index = decode_strategy(address_buffer);
-                tx->strategies[tx->strategies_count] =
-                    (strategy_index != UNKNOWN_STRATEGY) ? strategy_index : UNKNOWN_STRATEGY;
-
-                PRINTF("STRATEGY #: %d STRATEGY: %d\n", tx->strategies_count, strategy_index);
-            }
-
-            // we just processed one strategy item
-            tx->strategies_count += 1;
-            if (tx->current_item_count > 0) {
-                tx->current_item_count -= 1;
-            }
-            if (tx->current_item_count == 0) {
-                // when we arrive at the end of the strategies array we go to the shares array
-                context->next_param = SHARES_SIZE;
+            uint8_t strategy_index =
+                decode_strategy(context_registry(context), address_from_parameter(msg->parameter));
+            TRACE(TRACE_STRATEGY, msg->parameterOffset, strategy_index, tx->strategies.count);
+            if (!strategies_add(&tx->strategies, strategy_index)) {
+                msg->result = ETH_PLUGIN_RESULT_ERROR;
+                return;
             }
             break;
         }
+        case STRATEGIES_SIZE:
         case SHARES_SIZE:
-            if (!U2BE_from_parameter(msg->parameter, &tx->current_item_count)) {
+        case SHARE:
+            handle_shares(msg, &tx->strategies, field);
+            break;
+        case WITHDRAWER: {
+            uint8_t buffer[ADDRESS_LENGTH];
+            copy_address(buffer, msg->parameter, sizeof(buffer));
+            // we only support same withdrawer accross all the withdrawals
+            if (allzeroes(tx->withdrawer, sizeof(tx->withdrawer)) == 1) {
+                memcpy(tx->withdrawer, buffer, sizeof(tx->withdrawer));
+            } else if (memcmp(tx->withdrawer, buffer, sizeof(tx->withdrawer)) != 0) {
+                TRACE(TRACE_UNEXPECTED_WITHDRAWER, msg->parameterOffset, 0, 0);
                 msg->result = ETH_PLUGIN_RESULT_ERROR;
                 return;
-            };
-            // get number of items to parse
-
-            context->next_param = SHARE;
-            break;
-        case SHARE:  // get shares value and finish
-            // we skip parsing shares item as they are not needed for clearsigning
-            // as not having ETH / ERC20 amount to display would confuse users
-            if (tx->current_item_count > 0) {
-                tx->current_item_count -= 1;
             }
-            if (tx->current_item_count == 0) {
-                // here we arrive at the end of the queuedWithdrawal array element
-
-                // check if there are other queuedWithdrawals to parse
-                tx->queued_withdrawals_count -= 1;
-                if (tx->queued_withdrawals_count == 0) {
-                    // if not we finished parsing
-                    context->next_param = NONE;
-                } else {
-                    // if there are other queuedWithdrawals we go back to parsing the
-                    // next queueWithdrawal struct
-                    context->next_param = STRATEGY_OFFSET;
-                }
-            }
-            break;
-        case NONE:
             break;
+        }
         default:
-            PRINTF("Param not supported: %d\n", context->next_param);
+            TRACE(TRACE_UNSUPPORTED_FIELD, msg->parameterOffset, field, 0);
             msg->result = ETH_PLUGIN_RESULT_ERROR;
             break;
     }
 }
 
+/**
+ * @brief Check the length of an array holding one item per withdrawal
+ *
+ * @param msg: message containing the array length
+ * @param withdrawals_count: number of withdrawals
+ *
+ * @returns true if the array is not longer than the withdrawals array
+ */
+static bool check_withdrawals_array_length(const ethPluginProvideParameter_t *msg,
+                                           uint8_t withdrawals_count) {
+    uint16_t length;
+    if (!U2BE_from_parameter(msg->parameter, &length)) {
+        return false;
+    }
+    if (length > withdrawals_count) {
+        TRACE(TRACE_UNEXPECTED_ARRAY_LENGTH, msg->parameterOffset, withdrawals_count, length);
+        return false;
+    }
+    return true;
+}
+
 /**
  * @brief Handle the parameters for the completeQueuedWithdrawals selector
  *
  * @param msg: message containing the parameter
  * @param context: context to update
+ * @param field: parameter to capture
  *
  */
 static void handle_complete_queued_withdrawals(ethPluginProvideParameter_t *msg,
-                                               context_t *context) {
+                                               context_t *context,
+                                               uint8_t field) {
     complete_queued_withdrawals_t *tx = &context->tx.complete_queued_withdrawals;
 
-    switch (context->next_param) {
-        case WITHDRAWALS_OFFSET: {
-            uint16_t offset;
-            if (!U2BE_from_parameter(msg->parameter, &offset) || offset != 4 * PARAMETER_LENGTH) {
-                // valid offset should only skip this offset + tokens + middlewareTimesIndexes +
-                // receiveAsTokens offsets
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-
-            context->next_param = TOKEN_OFFSET;
-            break;
-        }
-        case TOKEN_OFFSET:
-            if (!U2BE_from_parameter(msg->parameter, &tx->tokens_offset)) {
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-            context->next_param = MIDDLEWARE_TIMES_OFFSET;
-            break;
-        case MIDDLEWARE_TIMES_OFFSET:
-            if (!U2BE_from_parameter(msg->parameter, &tx->middlewareTimesIndexes_offset)) {
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-            context->next_param = RECEIVE_AS_TOKENS_OFFSET;
-            break;
-        case RECEIVE_AS_TOKENS_OFFSET:
-            if (!U2BE_from_parameter(msg->parameter, &tx->receiveAsTokens_offset)) {
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-            context->next_param = WITHDRAWALS_SIZE;
-            break;
-        case WITHDRAWALS_SIZE:
-            if (!U2BE_from_parameter(msg->parameter, &tx->parent_item_count)) {
-                msg->result = ETH_PLUGIN_RESULT_UNSUCCESSFUL;
-            }
-            tx->current_item_count = tx->parent_item_count;
-
-            if (tx->parent_item_count == 0) {
-                context->next_param = TOKENS_SIZE;
-            } else {
-                context->next_param = WITHDRAWALS_ITEM_OFFSET;
-            }
-            break;
-        case WITHDRAWALS_ITEM_OFFSET: {
-            uint16_t offset;
-            if (!U2BE_from_parameter(msg->parameter, &offset)) {
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-
-            // We have limited size on the context and can't store all the offset values
-            // of the Withdrawal structs. So we compute their checksum and expect to
-            // be able to recompute it using the offset of the parsed structures later.
-            // _preview will be equal to _value at the end of the parsing if everything is fine
-            checksum_offset_params_t h_params;
-            memset(&h_params, 0, sizeof(h_params));
-            memcpy(&h_params.prev_checksum,
-                   &(tx->withdrawals_offsets_checksum_preview),
-                   sizeof(h_params.prev_checksum));
-            // we hash the previous checksum with the offset of the beginning of the structure.
-            // the offset we parse is actually after SELECTOR + the 5 above param so we add them to
-            // it.
-            h_params.new_offset = offset + SELECTOR_SIZE + PARAMETER_LENGTH * 5;
-            if (cx_keccak_256_hash((void *) &h_params,
-                                   sizeof(h_params),
-                                   tx->withdrawals_offsets_checksum_preview) != CX_OK) {
-                PRINTF("unable to compute keccak hash\n");
+    switch (field) {
+        case WITHDRAWER: {
+            // the withdrawer is parsed once per Withdrawal struct, before its strategies
+            if (tx->withdrawals_count == UINT8_MAX) {
                 msg->result = ETH_PLUGIN_RESULT_ERROR;
                 return;
             }
+            tx->withdrawals_count += 1;
 
-            if (tx->current_item_count > 0) {
-                tx->current_item_count -= 1;
-            }
-            if (tx->current_item_count == 0) {
-                context->next_param = STAKER;
-            }
-            break;
-        }
-        case STAKER: {
-            // here we are at the beginning of the queuedWithdrawal struct, so we want
-            // to compute the offset of the struct we're at for the queuedWithdrawal struct array
-            // offsets checksum
-
-            checksum_offset_params_t h_params;
-            memset(&h_params, 0, sizeof(h_params));
-            memcpy(&(h_params.prev_checksum),
-                   &(tx->withdrawals_offsets_checksum_value),
-                   sizeof(h_params.prev_checksum));
-            h_params.new_offset = msg->parameterOffset;
-
-            if (cx_keccak_256_hash((void *) &h_params,
-                                   sizeof(h_params),
-                                   tx->withdrawals_offsets_checksum_value) != CX_OK) {
-                PRINTF("unable to compute keccak hash\n");
+            uint8_t buffer[ADDRESS_LENGTH];
+            copy_address(buffer, msg->parameter, sizeof(buffer));
+            // we only support same withdrawer accross all the withdrawals
+            if (allzeroes(tx->withdrawer, sizeof(tx->withdrawer)) == 1) {
+                memcpy(tx->withdrawer, buffer, sizeof(tx->withdrawer));
+            } else if (memcmp(tx->withdrawer, buffer, sizeof(tx->withdrawer)) != 0) {
+                TRACE(TRACE_UNEXPECTED_WITHDRAWER, msg->parameterOffset, 0, 0);
                 msg->result = ETH_PLUGIN_RESULT_ERROR;
                 return;
             }
-
-            if (tx->parent_item_count == 1) {
-                // if we are on the last item of the array of withdrawal struct
-                // we can check the checksum
-                if (memcmp(tx->withdrawals_offsets_checksum_preview,
-                           tx->withdrawals_offsets_checksum_value,
-                           sizeof(tx->withdrawals_offsets_checksum_preview)) != 0) {
-                    PRINTF("Checksums do not match\n");
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-            }
-            context->next_param = DELEGATE_TO;
-            break;
-        }
-        case DELEGATE_TO:
-            context->next_param = WITHDRAWER;
-            break;
-        case WITHDRAWER: {
-            {
-                uint8_t buffer[ADDRESS_LENGTH];
-                copy_address(buffer, msg->parameter, sizeof(buffer));
-                // we only support same withdrawer accross all the withdrawals
-                if (allzeroes(tx->withdrawer, sizeof(tx->withdrawer)) == 1) {
-                    memcpy(tx->withdrawer, buffer, sizeof(tx->withdrawer));
-                } else if (strcmp((const char *) tx->withdrawer, (const char *) buffer) != 0) {
-                    PRINTF("Unexpected withdrawer address, %s != expected %s\n",
-                           msg->parameter,
-                           tx->withdrawer);
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-            }
-            context->next_param = NONCE;
             break;
         }
-        case NONCE:
-            context->next_param = START_BLOCK;
-            break;
-        case START_BLOCK:
-            context->next_param = STRATEGY_OFFSET;
-            break;
-        case STRATEGY_OFFSET: {
-            {
-                uint16_t offset;
-                if (!U2BE_from_parameter(msg->parameter, &offset)) {
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-
-                if (offset != PARAMETER_LENGTH * 7) {
-                    // valid offset should only skip the above elements in the structure + this one
-                    // + shares offset
-                    PRINTF("Unexpected parameter offset %d != %d\n", offset, PARAMETER_LENGTH * 7);
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-            }
-            context->next_param = SHARES_OFFSET;
-            break;
-        }
-        case SHARES_OFFSET: {
-            uint16_t offset;
-            if (!U2BE_from_parameter(msg->parameter, &offset)) {
+        case STRATEGY: {
+            // get strategy we need to display
+            uint8_t strategy =
+                decode_strategy(context_registry(context), address_from_parameter(msg->parameter));
+            if (!strategies_add(&tx->strategies, strategy)) {
                 msg->result = ETH_PLUGIN_RESULT_ERROR;
                 return;
             }
-
-            // save offset to verify it on array start
-            // offset starts at the beginning of the structure (current scope)
-            tx->cached_offset = offset + (msg->parameterOffset - PARAMETER_LENGTH * 6);
-
-            context->next_param = STRATEGY_SIZE;
+            sequence_digest_fold(&context->parser.offsets, &tx->strategies_digest, strategy);
             break;
         }
-        case STRATEGY_SIZE:
-            if (!U2BE_from_parameter(msg->parameter, &tx->current_item_count)) {
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-
-            if (tx->current_item_count == 0) {
-                context->next_param = SHARES_SIZE;
-            } else {
-                context->next_param = STRATEGY;
-            }
-            break;
-        case STRATEGY: {
-            // get strategy we need to display
-            {
-                uint8_t buffer[ADDRESS_LENGTH];
-                copy_address(buffer, msg->parameter, sizeof(buffer));
-                char address_buffer[ADDRESS_STR_LEN];
-                if (!getEthDisplayableAddress(buffer, address_buffer, sizeof(address_buffer), 0)) {
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-
-                uint8_t strategy_index = decode_strategy(address_buffer);
-                if (tx->strategies_count >= MAX_DISPLAYABLE_STRATEGIES) {
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-                uint8_t withdrawal = tx->withdrawals_count;
-
-                uint8_t strategy =
-                    (strategy_index != UNKNOWN_STRATEGY) ? strategy_index : UNKNOWN_STRATEGY;
-
-                if (withdrawal >= 16 || strategy >= 16) {
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-
-                tx->strategies[tx->strategies_count] = (withdrawal << 4) | (strategy & 0x0F);
-                ;
-            }
-
-            // we just processed one strategy item
-            tx->strategies_count += 1;
-            if (tx->current_item_count > 0) {
-                tx->current_item_count -= 1;
-            }
-            if (tx->current_item_count == 0) {
-                // when we arrive at the end of the strategies array we go to the shares
-                // array
-                context->next_param = SHARES_SIZE;
-            }
+        case STRATEGIES_SIZE:
+            sequence_digest_fold(&context->parser.offsets,
+                                 &tx->strategies_digest,
+                                 WITHDRAWAL_MARKER);
+            handle_shares(msg, &tx->strategies, field);
             break;
-        }
         case SHARES_SIZE:
-
-            if (tx->cached_offset != msg->parameterOffset) {
-                PRINTF("Unexpected shares parameter offset %d != %d\n",
-                       tx->cached_offset,
-                       msg->parameterOffset);
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-
-            if (!U2BE_from_parameter(msg->parameter, &tx->current_item_count)) {
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-
-            if (tx->current_item_count == 0 && tx->parent_item_count > 0) {
-                // shares array is empty AND we have other queuedWithdrawals to parse
-                tx->parent_item_count -= 1;
-                tx->withdrawals_count += 1;
-                context->next_param = STAKER;
-            } else {
-                context->next_param = SHARE;
-            }
-            break;
         case SHARE:
-            // we don't need to parse shares items as they are not needed for clearsigning
-            // as not having ETH / ERC20 amount to display would confuse users
-            if (tx->current_item_count > 0) {
-                tx->current_item_count -= 1;
-            }
-            if (tx->current_item_count == 0) {
-                // we arrive at the end of the Withdrawal struct
-                tx->parent_item_count -= 1;
-                tx->withdrawals_count += 1;
-                if (tx->parent_item_count == 0) {
-                    // we arrive at the end of the Withdrawals array
-                    context->next_param = TOKEN_SIZE;
-                } else {
-                    // we have other Withdrawals to parse
-                    context->next_param = STAKER;
-                }
-            }
+            handle_shares(msg, &tx->strategies, field);
             break;
-        case TOKEN_SIZE:
-
-            if (tx->tokens_offset != msg->parameterOffset - SELECTOR_SIZE) {
-                PRINTF("Unexpected tokens parameter offset %d != %d\n",
-                       tx->tokens_offset,
-                       msg->parameterOffset);
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-            if (!U2BE_from_parameter(msg->parameter, &tx->parent_item_count)) {
+        case TOKENS_SIZE:
+            if (!check_withdrawals_array_length(msg, tx->withdrawals_count)) {
                 msg->result = ETH_PLUGIN_RESULT_ERROR;
                 return;
             }
-
-            if (tx->parent_item_count > tx->withdrawals_count) {
-                PRINTF("Unexpected number of tokens, %d > withdrawals %d\n",
-                       tx->parent_item_count,
-                       tx->withdrawals_count);
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-
-            tx->current_item_count = tx->parent_item_count;
-            // reset checksums and cached offset
-            memset(&tx->withdrawals_offsets_checksum_preview,
-                   0,
-                   sizeof(tx->withdrawals_offsets_checksum_preview));
-            memset(&tx->withdrawals_offsets_checksum_value,
-                   0,
-                   sizeof(tx->withdrawals_offsets_checksum_value));
-            tx->cached_offset = 0;
-
-            if (tx->parent_item_count == 0) {
-                context->next_param = MIDDLEWARE_TIMES_SIZE;
-            } else {
-                context->next_param = TOKEN_OFFSET_ITEMS;
-            }
-            break;
-        case TOKEN_OFFSET_ITEMS: {
-            {
-                // We have limited size on the context and can't store all the offset values
-                // of the tokens structs. So we compute their checksum and expect to
-                // be able to recompute it using the offset of the parsed items later.
-                // _preview will be equal to _value at the end of the parsing if everything is
-                // fine
-                checksum_offset_params_t h_params;
-                memset(&h_params, 0, sizeof(h_params));
-                memcpy(&h_params.prev_checksum,
-                       &(tx->withdrawals_offsets_checksum_preview),
-                       sizeof(h_params.prev_checksum));
-                // we hash the previous checksum with the offset we receive.
-                uint16_t offset;
-                if (!U2BE_from_parameter(msg->parameter, &offset)) {
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-                // if we are on the first element of the array, we save the offset, which all
-                // received offset values will be based on for checksum computation
-                if (tx->cached_offset == 0) {
-                    tx->cached_offset = msg->parameterOffset;
-                }
-
-                h_params.new_offset = offset + tx->cached_offset;
-
-                if (cx_keccak_256_hash((void *) &h_params,
-                                       sizeof(h_params),
-                                       tx->withdrawals_offsets_checksum_preview) != CX_OK) {
-                    PRINTF("unable to compute keccak hash\n");
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-            }
-
-            if (tx->current_item_count > 0) {
-                tx->current_item_count -= 1;
-            }
-            if (tx->current_item_count == 0) {
-                context->next_param = TOKENS_ITEM_SIZE;
-            }
             break;
-        }
-        case TOKENS_ITEM_SIZE: {
-            {
-                checksum_offset_params_t h_params;
-                memset(&h_params, 0, sizeof(h_params));
-                memcpy(&h_params.prev_checksum,
-                       &(tx->withdrawals_offsets_checksum_value),
-                       sizeof(h_params.prev_checksum));
-                // we hash the previous checksum with the offset of the beginning of the
-                // structure.
-                h_params.new_offset = msg->parameterOffset;
-
-                if (cx_keccak_256_hash((void *) &h_params,
-                                       sizeof(h_params),
-                                       tx->withdrawals_offsets_checksum_value) != CX_OK) {
-                    PRINTF("unable to compute keccak hash\n");
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-            }
-
-            if (!U2BE_from_parameter(msg->parameter, &tx->current_item_count)) {
+        case WITHDRAWAL_TOKENS_SIZE: {
+            uint16_t length;
+            if (!U2BE_from_parameter(msg->parameter, &length)) {
                 msg->result = ETH_PLUGIN_RESULT_ERROR;
                 return;
             }
-
-            if (tx->parent_item_count == 1) {
-                // if we are on the last item of the array of tokens struct
-                // we can check the checksum
-                if (memcmp(tx->withdrawals_offsets_checksum_preview,
-                           tx->withdrawals_offsets_checksum_value,
-                           sizeof(tx->withdrawals_offsets_checksum_preview)) != 0) {
-                    PRINTF("Checksums do not match\n");
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-            }
-
-            if (tx->current_item_count == 0) {
-                context->next_param = MIDDLEWARE_TIMES_SIZE;
-            } else {
-                context->next_param = TOKENS_ITEM_ELEMENT;
+            // an empty tokens array can only be a withdrawal received as shares, see
+            // finalize_completed_withdrawals
+            sequence_digest_fold(&context->parser.offsets, &tx->tokens_digest, WITHDRAWAL_MARKER);
+            if (length > 0) {
+                tx->tokens_withdrawals += 1;
             }
-
             break;
         }
-        case TOKENS_ITEM_ELEMENT: {
-            {
-                uint8_t buffer[ADDRESS_LENGTH];
-                copy_address(buffer, msg->parameter, sizeof(buffer));
-                char address_buffer[ADDRESS_STR_LEN];
-                if (!getEthDisplayableAddress(buffer, address_buffer, sizeof(address_buffer), 0)) {
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-
-                uint8_t token_index = decode_token(address_buffer);
-                // we check if the token matches the corresponding strategy
-                uint8_t strategy_index = tx->strategies[tx->tokens_count] & 0x0F;
-                if (strategy_index != UNKNOWN_STRATEGY && token_index != strategy_index) {
-                    PRINTF("Token idx %d does not match strategy idx %d\n",
-                           token_index,
-                           strategy_index);
-                    msg->result = ETH_PLUGIN_RESULT_ERROR;
-                    return;
-                }
-
-                tx->tokens_count += 1;
-            }
-
-            if (tx->current_item_count > 0) {
-                tx->current_item_count -= 1;
-            }
-            if (tx->current_item_count == 0) {
-                // we arrive at the end of the tokens array
-                tx->parent_item_count -= 1;
-                if (tx->parent_item_count == 0) {
-                    // if we don't have other Tokens to parse
-                    context->next_param = MIDDLEWARE_TIMES_SIZE;
-                } else {
-                    // if we have other Tokens to parse
-                    context->next_param = TOKEN_SIZE;
-                }
-            }
+        case TOKEN: {
+            // the strategy of the token, checked against the strategies once all are parsed. An
+            // unknown token folds UNKNOWN_TOKEN, which only pairs with an unknown strategy
+            uint8_t token_index =
+                decode_token(context_registry(context), address_from_parameter(msg->parameter));
+            sequence_digest_fold(&context->parser.offsets, &tx->tokens_digest, token_index);
             break;
         }
         case MIDDLEWARE_TIMES_SIZE:
-
-            if (tx->middlewareTimesIndexes_offset != msg->parameterOffset - SELECTOR_SIZE) {
-                PRINTF("Unexpected middlewareTimesIndexes parameter offset %d != %d\n",
-                       tx->middlewareTimesIndexes_offset,
-                       msg->parameterOffset);
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-
-            if (!U2BE_from_parameter(msg->parameter, &tx->current_item_count)) {
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-            if (tx->current_item_count > tx->withdrawals_count) {
-                PRINTF("Unexpected middlewareTimesIndexes parameter length %d > withdrawals %d\n ",
-                       tx->current_item_count,
-                       msg->parameterOffset);
+        case RECEIVE_AS_TOKENS_SIZE:
+            if (!check_withdrawals_array_length(msg, tx->withdrawals_count)) {
                 msg->result = ETH_PLUGIN_RESULT_ERROR;
                 return;
             }
-
-            if (tx->current_item_count == 0) {
-                context->next_param = RECEIVE_AS_TOKEN_SIZE;
-            } else {
-                context->next_param = MIDDLEWARE_TIMES_ITEM;
-            }
             break;
-        case MIDDLEWARE_TIMES_ITEM:
-            if (tx->current_item_count > 0) {
-                tx->current_item_count -= 1;
-            }
-            if (tx->current_item_count == 0) {
-                context->next_param = RECEIVE_AS_TOKEN_SIZE;
-            }
+        default:
+            TRACE(TRACE_UNSUPPORTED_FIELD, msg->parameterOffset, field, 0);
+            msg->result = ETH_PLUGIN_RESULT_ERROR;
             break;
-        case RECEIVE_AS_TOKEN_SIZE:
-
-            if (tx->receiveAsTokens_offset != msg->parameterOffset - SELECTOR_SIZE) {
-                PRINTF("Unexpected receiveAsTokens parameter offset %d != %d\n",
-                       tx->receiveAsTokens_offset,
-                       msg->parameterOffset);
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-
-            if (!U2BE_from_parameter(msg->parameter, &tx->current_item_count)) {
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-            if (tx->current_item_count > tx->withdrawals_count) {
-                PRINTF("Unexpected receiveAsTokens length %d > withdrawals length %d\n",
-                       tx->current_item_count,
-                       tx->withdrawals_count);
-                msg->result = ETH_PLUGIN_RESULT_ERROR;
-                return;
-            }
-            // we save the number of redelegations to parse
-            tx->relegations_count = tx->current_item_count;
+    }
+}
 
-            if (tx->current_item_count == 0) {
-                // reached the end
-                context->next_param = NONE;
-            } else {
-                context->next_param = RECEIVE_AS_TOKEN_ITEM;
-            }
-            break;
-        case RECEIVE_AS_TOKEN_ITEM: {
-            if (tx->current_item_count > 0) {
-                tx->current_item_count -= 1;
-            }
-            if (tx->current_item_count == 0) {
-                // reached the end
-                context->next_param = NONE;
-            }
+/**
+ * @brief Handle the parameters for the processClaim selector
+ *
+ * @param msg: message containing the parameter
+ * @param context: context to update
+ * @param field: parameter to capture
+ *
+ */
+static void handle_process_claim(ethPluginProvideParameter_t *msg,
+                                 context_t *context,
+                                 uint8_t field) {
+    process_claim_t *tx = &context->tx.process_claim;
+
+    switch (field) {
+        case TOKEN: {
+            // the token of a leaf, followed by its earnings
+            uint8_t token =
+                decode_token(context_registry(context), address_from_parameter(msg->parameter));
+            TRACE(TRACE_TOKEN, msg->parameterOffset, token, tx->earnings_length);
+            rewards_add_token(tx, token);
             break;
         }
-        case NONE:
+        case EARNINGS:
+            rewards_add_earnings(tx, msg->parameter);
+            break;
+        case RECIPIENT:
+            copy_address(tx->recipient.value, msg->parameter, sizeof(tx->recipient.value));
             break;
         default:
-            PRINTF("Param not supported: %d\n", context->next_param);
+            TRACE(TRACE_UNSUPPORTED_FIELD, msg->parameterOffset, field, 0);
             msg->result = ETH_PLUGIN_RESULT_ERROR;
             break;
     }
 }
 
+#define TO_PARAMETER_CASE(name, selector, label, screens, finalize, handler) \
+    case name:                                                               \
+        handle_##handler(msg, context, field);                               \
+        break;
+
 void handle_provide_parameter(ethPluginProvideParameter_t *msg) {
     context_t *context = (context_t *) msg->pluginContext;
-    // We use `%.*H`: it's a utility function to print bytes. You first give
-    // the number of bytes you wish to print (in this case, `PARAMETER_LENGTH`) and then
-    // the address (here `msg->parameter`).
-    PRINTF("plugin provide parameter: offset %d\nBytes: %.*H\n",
-           msg->parameterOffset,
-           PARAMETER_LENGTH,
-           msg->parameter);
+    uint8_t field;
+    TRACE(TRACE_PARAMETER,
+          msg->parameterOffset,
+          0,
+          U4BE(msg->parameter, PARAMETER_LENGTH - sizeof(uint32_t)));
 
     msg->result = ETH_PLUGIN_RESULT_OK;
 
+    if (context->go_to_offset) {
+        // inside a region the parser jumped over, such as a Merkle proof, it must end exactly at
+        // `offset`: the context is only written at its end
+        uint32_t end = msg->parameterOffset + PARAMETER_LENGTH;
+        if (end > context->parser.offset) {
+            TRACE(TRACE_SKIPPED_PAST_OFFSET, msg->parameterOffset, 0, context->parser.offset);
+            msg->result = ETH_PLUGIN_RESULT_ERROR;
+            return;
+        }
+        if (end == context->parser.offset) {
+            context->go_to_offset = 0;
+        }
+        return;
+    }
+
+    // the generated tables walk the ABI of the selector and tell which parameters to capture,
+    // every offset is checked by the parser
+    if (!parser_parse(&context->parser,
+                      msg->parameter,
+                      msg->parameterOffset,
+                      context->size,
+                      &field)) {
+        msg->result = ETH_PLUGIN_RESULT_ERROR;
+        return;
+    }
+    // bytes and arrays of skipped words are not parsed, only counted until their end
+    context->go_to_offset = (parser_skipping(&context->parser, msg->parameterOffset) != 0);
+    if (context->go_to_offset) {
+        TRACE(TRACE_SKIP, msg->parameterOffset, 0, context->parser.offset);
+    }
+    if (field == NONE) {
+        return;
+    }
+
     switch (context->selectorIndex) {
-        case DEPOSIT_INTO_STRATEGY:
-            handle_deposit_into_strategy(msg, context);
-            break;
-        case UNDELEGATE:
-            handle_undelegate(msg, context);
-            break;
-        case DELEGATE_TO:
-            handle_delegate(msg, context);
-            break;
-        case QUEUE_WITHDRAWAL_PARAMS:
-            handle_queue_withdrawal(msg, context);
-            break;
-        case COMPLETE_QUEUED_WITHDRAWALS:
-            handle_complete_queued_withdrawals(msg, context);
-            break;
+        SELECTORS_LIST(TO_PARAMETER_CASE)
         default:
-            PRINTF("Selector Index not supported: %d\n", context->selectorIndex);
+            TRACE(TRACE_UNSUPPORTED_SELECTOR, msg->parameterOffset, context->selectorIndex, 0);
             msg->result = ETH_PLUGIN_RESULT_ERROR;
             break;
     }
@@ -9,30 +9,11 @@ void handle_query_contract_id(ethQueryContractID_t *msg) {
     // For the first screen, display the plugin name.
     strlcpy(msg->name, APPNAME, msg->nameLength);
 
-    switch (context->selectorIndex) {
-        case DEPOSIT_INTO_STRATEGY:
-            strlcpy(msg->version, "Deposit into Strategy", msg->versionLength);
-            msg->result = ETH_PLUGIN_RESULT_OK;
-            break;
-        case DELEGATE_TO:
-            strlcpy(msg->version, "Delegate to", msg->versionLength);
-            msg->result = ETH_PLUGIN_RESULT_OK;
-            break;
-        case UNDELEGATE:
-            strlcpy(msg->version, "Undelegate", msg->versionLength);
-            msg->result = ETH_PLUGIN_RESULT_OK;
-            break;
-        case QUEUE_WITHDRAWAL_PARAMS:
-            strlcpy(msg->version, "Queued Withdrawal", msg->versionLength);
-            msg->result = ETH_PLUGIN_RESULT_OK;
-            break;
-        case COMPLETE_QUEUED_WITHDRAWALS:
-            strlcpy(msg->version, "Complete Queued Withdrawals", msg->versionLength);
-            msg->result = ETH_PLUGIN_RESULT_OK;
-            break;
-        default:
-            PRINTF("Selector index: %d not supported\n", context->selectorIndex);
-            msg->result = ETH_PLUGIN_RESULT_ERROR;
-            return;
+    if (context->selectorIndex >= SELECTOR_COUNT) {
+        TRACE(TRACE_UNSUPPORTED_SELECTOR, 0, context->selectorIndex, 0);
+        msg->result = ETH_PLUGIN_RESULT_ERROR;
+        return;
     }
+    strlcpy(msg->version, SELECTOR_LABELS[context->selectorIndex], msg->versionLength);
+    msg->result = ETH_PLUGIN_RESULT_OK;
 }
@@ -29,11 +29,55 @@ static bool set_address_ui(ethQueryContractUI_t *msg, address_t *value) {
         chainid);
 }
 
+/**
+ * @brief Set UI for the withdrawer screen, the address is only formatted here.
+ *
+ * @param msg: message containing the parameter
+ * @param withdrawer: binary address of the withdrawer
+ *
+ */
+static bool set_withdrawer_ui(ethQueryContractUI_t *msg, uint8_t withdrawer[ADDRESS_LENGTH]) {
+    char address_buffer[ADDRESS_STR_LEN];
+
+    strlcpy(msg->title, "Withdrawer", msg->titleLength);
+    if (!getEthDisplayableAddress(withdrawer, address_buffer, sizeof(address_buffer), 0)) {
+        return false;
+    }
+    strlcpy(msg->msg, address_buffer, msg->msgLength);
+    return true;
+}
+
 static bool set_addr_ui(ethQueryContractUI_t *msg, address_t *address, const char *title) {
     strlcpy(msg->title, title, msg->titleLength);
     return set_address_ui(msg, address);
 }
 
+/**
+ * @brief UI for undelegate selector
+ *
+ * @param msg: message containing the parameter
+ * @param context: context with provide_parameter data
+ * @param screenIndex: index of the screen to display
+ *
+ */
+static bool handle_undelegate(ethQueryContractUI_t *msg, context_t *context, uint8_t screenIndex) {
+    (void) screenIndex;
+    return set_addr_ui(msg, &context->tx.undelegate.staker, "Staker");
+}
+
+/**
+ * @brief UI for delegateTo selector
+ *
+ * @param msg: message containing the parameter
+ * @param context: context with provide_parameter data
+ * @param screenIndex: index of the screen to display
+ *
+ */
+static bool handle_delegate_to(ethQueryContractUI_t *msg, context_t *context, uint8_t screenIndex) {
+    (void) screenIndex;
+    return set_addr_ui(msg, &context->tx.delegate_to.operator, "Operator");
+}
+
 /**
  * @brief UI for depositIntoStrategy selector
  *
@@ -45,34 +89,87 @@ static bool set_addr_ui(ethQueryContractUI_t *msg, address_t *address, const cha
 static bool handle_deposit_into_strategy(ethQueryContractUI_t *msg,
                                          context_t *context,
                                          uint8_t screenIndex) {
+    const registry_t *registry = context_registry(context);
+    const char *ticker;
+
     switch (screenIndex) {
         case 0:
             strlcpy(msg->title, "Strategy", msg->titleLength);
-            if (context->tx.deposit_into_strategy.strategy == UNKNOWN_STRATEGY) {
-                strlcpy(msg->msg, "UNKNOWN", msg->msgLength);
-            } else {
-                strlcpy(msg->msg,
-                        tickers[context->tx.deposit_into_strategy.strategy],
-                        MAX_TICKER_LEN);
+            ticker = strategies_ticker(registry, context->tx.deposit_into_strategy.strategy);
+            if (ticker == NULL) {
+                return false;
             }
+            strlcpy(msg->msg, ticker, msg->msgLength);
             return true;
         case 1:
             strlcpy(msg->title, "Amount", msg->titleLength);
-            amountToString(context->tx.deposit_into_strategy.amount.value,
-                           sizeof(context->tx.deposit_into_strategy.amount.value),
+            ticker = strategies_ticker(registry, context->tx.deposit_into_strategy.token);
+            if (ticker == NULL) {
+                return false;
+            }
+            amountToString(context->tx.deposit_into_strategy.amount,
+                           sizeof(context->tx.deposit_into_strategy.amount),
                            ERC20_DECIMALS,
-                           context->tx.deposit_into_strategy.token == UNKNOWN_TOKEN
-                               ? "UNKNOWN"
-                               : tickers[context->tx.deposit_into_strategy.token],
+                           ticker,
                            msg->msg,
                            msg->msgLength);
             return true;
         default:
-            PRINTF("Received an invalid screenIndex\n");
+            TRACE(TRACE_INVALID_SCREEN, 0, screenIndex, 0);
             return false;
     }
 }
 
+/**
+ * @brief Set UI for a strategy screen of queueWithdrawals or completeQueuedWithdrawals, a page
+ * of distinct strategies with their total shares, one strategy per page on small screens
+ *
+ * @param msg: message containing the parameter
+ * @param strategies: strategies of the batch
+ * @param registry: registry of the chain of the transaction
+ * @param total_title: title of the total shares screens
+ * @param page: index of the page
+ *
+ */
+static bool set_strategy_ui(ethQueryContractUI_t *msg,
+                            const strategies_t *strategies,
+                            const registry_t *registry,
+                            const char *total_title,
+                            uint8_t page) {
+    uint8_t first;
+    uint8_t size;
+
+    // the pages were counted in handle_finalize for this message length
+    if (msg->msgLength <= STRATEGIES_PAGE_LENGTH ||
+        !strategies_page(strategies, registry, page, &first, &size)) {
+        TRACE(TRACE_INVALID_SCREEN, 0, page, 0);
+        return false;
+    }
+    switch (strategies_title(strategies, first)) {
+        case STRATEGY_TOTAL:
+            strlcpy(msg->title, total_title, msg->titleLength);
+            break;
+        case STRATEGY_NO_TOTAL:
+            // the shares of a known strategy are summed unless its total did not fit
+            strlcpy(msg->title, "Shares not shown", msg->titleLength);
+            break;
+        default:
+            strlcpy(msg->title, "Strategy", msg->titleLength);
+            break;
+    }
+    msg->msg[0] = '\0';
+    for (uint8_t i = first; i < first + size; i++) {
+        if (i > first) {
+            strlcat(msg->msg, STRATEGIES_SEPARATOR, msg->msgLength);
+        }
+        size_t used = strlen(msg->msg);
+        if (!strategies_text(strategies, registry, i, msg->msg + used, msg->msgLength - used)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /**
  * @brief UI for queueWithdrawal selector
  *
@@ -88,32 +185,15 @@ static bool handle_queue_withdrawal(ethQueryContractUI_t *msg,
 
     switch (screenIndex) {
         case 0:
-            strlcpy(msg->title, "Withdrawer", msg->titleLength);
-            strlcpy(msg->msg, params->withdrawer, msg->msgLength);
-            return true;
-        default: {
+            return set_withdrawer_ui(msg, params->withdrawer);
+        default:
             // removing the first screen to current screen index
-            // to get the index of the withdrawal
-            uint8_t withdrawal_index = msg->screenIndex - 1;
-
-            if (withdrawal_index < params->strategies_count) {
-                strlcpy(msg->title, "Strategy", msg->titleLength);
-                uint8_t strategy = params->strategies[withdrawal_index];
-
-                if (strategy == UNKNOWN_STRATEGY) {
-                    strlcpy(msg->msg, "UNKNOWN", msg->msgLength);
-                } else {
-                    if (strategy > STRATEGIES_COUNT) {
-                        return false;
-                    }
-                    strlcpy(msg->msg, tickers[strategy], msg->msgLength);
-                }
-            }
-
-            return true;
-        }
-            PRINTF("Received an invalid screenIndex\n");
-            return false;
+            // to get the index of the strategy
+            return set_strategy_ui(msg,
+                                   &params->strategies,
+                                   context_registry(context),
+                                   "Total shares",
+                                   screenIndex - 1);
     }
 }
 
@@ -132,31 +212,74 @@ static bool handle_complete_queued_withdrawals(ethQueryContractUI_t *msg,
 
     switch (screenIndex) {
         case 0:
-            strlcpy(msg->title, "Withdrawer", msg->titleLength);
-            char address_buffer[ADDRESS_STR_LEN];
-            getEthDisplayableAddress(params->withdrawer, address_buffer, sizeof(address_buffer), 0);
-            strlcpy(msg->msg, address_buffer, msg->msgLength);
-            return true;
-        default: {
-            uint8_t strategy_index = msg->screenIndex - 1;
-
-            if (strategy_index < params->strategies_count) {
-                strlcpy(msg->title, "Strategy", msg->titleLength);
-                uint8_t strategy = params->strategies[strategy_index];
-
-                if (strategy == UNKNOWN_STRATEGY) {
-                    strlcpy(msg->msg, "UNKNOWN", msg->msgLength);
-                } else {
-                    strlcpy(msg->msg, tickers[strategy], msg->msgLength);
-                }
-            }
-            return true;
-        }
-            PRINTF("Received an invalid screenIndex\n");
-            return false;
+            return set_withdrawer_ui(msg, params->withdrawer);
+        default:
+            // since the slashing release, the shares are scaled by the slashing factors of the
+            // staker when the withdrawal is completed
+            return set_strategy_ui(msg,
+                                   &params->strategies,
+                                   context_registry(context),
+                                   (context->selectorIndex == COMPLETE_QUEUED_WITHDRAWALS_SLASHING)
+                                       ? "Scaled shares"
+                                       : "Total shares",
+                                   screenIndex - 1);
+    }
+}
+
+/**
+ * @brief UI for processClaim selector
+ *
+ * @param msg: message containing the parameter
+ * @param context: context with provide_parameter data
+ * @param screenIndex: index of the screen to display
+ *
+ */
+static bool handle_process_claim(ethQueryContractUI_t *msg,
+                                 context_t *context,
+                                 uint8_t screenIndex) {
+    process_claim_t *params = &context->tx.process_claim;
+
+    if (screenIndex == 0) {
+        return set_addr_ui(msg, &params->recipient, "Recipient");
+    }
+    if (screenIndex - 1 >= rewards_screens(params)) {
+        TRACE(TRACE_INVALID_SCREEN, 0, screenIndex, 0);
+        return false;
+    }
+
+    if (screenIndex == rewards_screens(params) && params->hidden > 0) {
+        // the leaves that do not fit are counted, their tokens are not known anymore
+        strlcpy(msg->title, "Leaves not shown", msg->titleLength);
+        return amountToString(&params->hidden, 1, 0, "", msg->msg, msg->msgLength);
     }
+
+    uint8_t token;
+    uint8_t size = 0;
+    const uint8_t *earnings = rewards_leaf(params, screenIndex - 1, &token, &size);
+    const char *ticker = strategies_ticker(context_registry(context), token);
+    if (ticker == NULL) {
+        return false;
+    }
+    if (token == UNKNOWN_TOKEN) {
+        strlcpy(msg->title, "Token", msg->titleLength);
+        strlcpy(msg->msg, ticker, msg->msgLength);
+        return true;
+    }
+    if (earnings == NULL) {
+        strlcpy(msg->title, "Earnings not shown", msg->titleLength);
+        strlcpy(msg->msg, ticker, msg->msgLength);
+        return true;
+    }
+    // the transfer is the part of the cumulative earnings that was not claimed yet
+    strlcpy(msg->title, "Cumulative earnings", msg->titleLength);
+    return amountToString(earnings, size, ERC20_DECIMALS, ticker, msg->msg, msg->msgLength);
 }
 
+#define TO_UI_CASE(name, selector, label, screens, finalize, handler) \
+    case name:                                                        \
+        ret = handle_##handler(msg, context, msg->screenIndex);       \
+        break;
+
 void handle_query_contract_ui(ethQueryContractUI_t *msg) {
     context_t *context = (context_t *) msg->pluginContext;
     bool ret = false;
@@ -169,23 +292,9 @@ void handle_query_contract_ui(ethQueryContractUI_t *msg) {
     memset(msg->msg, 0, msg->msgLength);
 
     switch (context->selectorIndex) {
-        case DEPOSIT_INTO_STRATEGY:
-            ret = handle_deposit_into_strategy(msg, context, msg->screenIndex);
-            break;
-        case UNDELEGATE:
-            ret = set_addr_ui(msg, &context->tx.undelegate.staker, "Staker");
-            break;
-        case DELEGATE_TO:
-            ret = set_addr_ui(msg, &context->tx.delegate_to.operator, "Operator");
-            break;
-        case QUEUE_WITHDRAWAL_PARAMS:
-            ret = handle_queue_withdrawal(msg, context, msg->screenIndex);
-            break;
-        case COMPLETE_QUEUED_WITHDRAWALS:
-            ret = handle_complete_queued_withdrawals(msg, context, msg->screenIndex);
-            break;
+        SELECTORS_LIST(TO_UI_CASE)
         default:
-            PRINTF("Selector index: %d not supported\n", context->selectorIndex);
+            TRACE(TRACE_UNSUPPORTED_SELECTOR, 0, context->selectorIndex, 0);
             ret = false;
     }
     msg->result = ret ? ETH_PLUGIN_RESULT_OK : ETH_PLUGIN_RESULT_ERROR;
@@ -0,0 +1,110 @@
+#include "plugin.h"
+
+// Mersenne prime 2^31 - 1, every fingerprint value lives in [0, MODULUS)
+#define MODULUS 0x7FFFFFFFu
+
+/**
+ * @brief Reduce a value modulo 2^31 - 1
+ *
+ * @param value: value to reduce
+ *
+ * @returns value mod 2^31 - 1
+ */
+static uint32_t reduce(uint64_t value) {
+    // 2^31 is congruent to 1, so the high bits can be folded onto the low ones
+    value = (value & MODULUS) + (value >> 31);
+    value = (value & MODULUS) + (value >> 31);
+    return (value >= MODULUS) ? (uint32_t) (value - MODULUS) : (uint32_t) value;
+}
+
+/**
+ * @brief Add a (head, offset) pair to a multiset fingerprint
+ *
+ * @param fingerprint: fingerprint values, one per lane
+ * @param verifier: verifier holding the evaluation points
+ * @param head: calldata offset of the head parameter
+ * @param offset: calldata offset of the dynamic parameter
+ *
+ */
+static void fold(uint32_t fingerprint[OFFSETS_VERIFIER_LANES],
+                 const offsets_verifier_t *verifier,
+                 uint16_t head,
+                 uint16_t offset) {
+    for (size_t i = 0; i < OFFSETS_VERIFIER_LANES; i++) {
+        // the random weight binds the offset to its head, so swapping two heads is detected
+        uint32_t element = reduce((uint64_t) head * verifier->weight[i] + offset);
+        fingerprint[i] =
+            reduce((uint64_t) fingerprint[i] * (verifier->point[i] + MODULUS - element));
+    }
+}
+
+/**
+ * @brief Draw new evaluation points and clear both fingerprints
+ *
+ * @param verifier: verifier to initialize
+ *
+ */
+void offsets_verifier_init(offsets_verifier_t *verifier) {
+    cx_rng_no_throw((uint8_t *) verifier->point, sizeof(verifier->point));
+    cx_rng_no_throw((uint8_t *) verifier->weight, sizeof(verifier->weight));
+    for (size_t i = 0; i < OFFSETS_VERIFIER_LANES; i++) {
+        verifier->point[i] %= MODULUS;
+        // 0 would not bind offsets to their heads
+        verifier->weight[i] = 1 + verifier->weight[i] % (MODULUS - 1);
+        // empty products
+        verifier->announced[i] = 1;
+        verifier->observed[i] = 1;
+    }
+}
+
+/**
+ * @brief Record an offset read in a head parameter
+ *
+ * @param verifier: verifier to update
+ * @param head: calldata offset of the head parameter
+ * @param offset: absolute calldata offset announced by the head parameter
+ *
+ */
+void offsets_verifier_announce(offsets_verifier_t *verifier, uint16_t head, uint16_t offset) {
+    fold(verifier->announced, verifier, head, offset);
+}
+
+/**
+ * @brief Record the offset at which a dynamic parameter actually starts
+ *
+ * @param verifier: verifier to update
+ * @param head: calldata offset of the head parameter of the dynamic parameter
+ * @param offset: calldata offset of the dynamic parameter
+ *
+ */
+void offsets_verifier_observe(offsets_verifier_t *verifier, uint16_t head, uint16_t offset) {
+    fold(verifier->observed, verifier, head, offset);
+}
+
+/**
+ * @brief Check the announced offsets match the observed ones, once every dynamic parameter has
+ * been observed
+ *
+ * @param verifier: verifier to check
+ *
+ * @returns true if every head announced the offset of its own dynamic parameter
+ */
+bool offsets_verifier_match(const offsets_verifier_t *verifier) {
+    return memcmp(verifier->announced, verifier->observed, sizeof(verifier->announced)) == 0;
+}
+
+/**
+ * @brief Append a value to the running digest of a sequence. The digest is the polynomial whose
+ * coefficients are the values plus one, evaluated at the first point of the verifier, so two
+ * different sequences of at most n values only have the same digest with probability n / 2^31.
+ * It takes constant memory to check that two sequences parsed at different times are equal.
+ *
+ * @param verifier: verifier holding the evaluation point, drawn at random on the device
+ * @param digest: digest to update, 0 for the empty sequence
+ * @param value: next value of the sequence
+ *
+ */
+void sequence_digest_fold(const offsets_verifier_t *verifier, uint32_t *digest, uint8_t value) {
+    // Horner's rule, the coefficients are not 0 so sequences of different lengths differ
+    *digest = reduce((uint64_t) *digest * verifier->point[0] + value + 1);
+}
@@ -0,0 +1,283 @@
+#include "plugin_utils.h"
+#include "plugin.h"
+
+/**
+ * @brief Start parsing a new tuple or array
+ *
+ * @param parser: parser to update
+ * @param node: index of the tuple or array in PARSER_NODES
+ *
+ * @returns false if the maximum nesting is reached
+ */
+static bool push(parser_t *parser, uint8_t node) {
+    if (parser->depth >= PARSER_MAX_DEPTH) {
+        TRACE(TRACE_MAX_DEPTH, parser->offset, node, 0);
+        return false;
+    }
+    parser_frame_t *frame = &parser->frames[parser->depth++];
+    memset(frame, 0, sizeof(*frame));
+    frame->node = node;
+    frame->base = parser->offset;
+    if (PARSER_NODES[node].kind == ABI_TUPLE) {
+        frame->index = PARSER_NODES[node].child;
+        frame->phase = PARSER_HEAD;
+    } else {
+        frame->phase = PARSER_LENGTH;
+    }
+    return true;
+}
+
+/**
+ * @brief Skip the transitions that do not consume a parameter (entering static tuples, starting
+ * dynamic parameters and leaving finished tuples or arrays), until the parser needs a parameter
+ *
+ * @param parser: parser to update
+ *
+ * @returns false if the calldata layout is not supported
+ */
+static bool settle(parser_t *parser) {
+    while (parser->depth > 0) {
+        parser_frame_t *frame = &parser->frames[parser->depth - 1];
+        const abi_node_t *node = &PARSER_NODES[frame->node];
+        uint8_t child;
+
+        if (frame->phase == PARSER_LENGTH) {
+            return true;
+        }
+        if (node->kind == ABI_TUPLE && frame->phase == PARSER_HEAD) {
+            if (frame->index == PARSER_NO_NODE) {
+                // all heads parsed, go back to the first field for the dynamic ones
+                frame->phase = PARSER_TAIL;
+                frame->index = node->child;
+                continue;
+            }
+            child = frame->index;
+            if (PARSER_NODES[child].kind != ABI_TUPLE ||
+                (PARSER_NODES[child].flags & ABI_DYNAMIC)) {
+                return true;
+            }
+            // static tuples are encoded in place
+            frame->index = PARSER_NODES[child].next;
+            if (!push(parser, child)) {
+                return false;
+            }
+            continue;
+        }
+        if (node->kind == ABI_TUPLE) {
+            while (frame->index != PARSER_NO_NODE &&
+                   !(PARSER_NODES[frame->index].flags & ABI_DYNAMIC)) {
+                frame->index = PARSER_NODES[frame->index].next;
+            }
+            if (frame->index == PARSER_NO_NODE) {
+                parser->depth -= 1;
+                continue;
+            }
+            child = frame->index;
+            frame->index = PARSER_NODES[child].next;
+            offsets_verifier_observe(&parser->offsets,
+                                     frame->base + PARAMETER_LENGTH * PARSER_NODES[child].head,
+                                     parser->offset);
+            if (!push(parser, child)) {
+                return false;
+            }
+            continue;
+        }
+
+        // arrays and bytes
+        child = node->child;
+        if (frame->index == frame->count) {
+            if (frame->phase == PARSER_HEAD && frame->count > 0 && node->kind == ABI_ARRAY &&
+                (PARSER_NODES[child].flags & ABI_DYNAMIC)) {
+                // all offsets parsed, go back to the first element
+                frame->phase = PARSER_TAIL;
+                frame->index = 0;
+                continue;
+            }
+            parser->depth -= 1;
+            continue;
+        }
+        if (frame->phase == PARSER_TAIL) {
+            offsets_verifier_observe(&parser->offsets,
+                                     frame->base + PARAMETER_LENGTH * frame->index,
+                                     parser->offset);
+        } else if (node->kind == ABI_BYTES || PARSER_NODES[child].kind != ABI_TUPLE ||
+                   (PARSER_NODES[child].flags & ABI_DYNAMIC)) {
+            return true;
+        }
+        // static tuple elements are encoded in place
+        frame->index += 1;
+        if (!push(parser, child)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Tell whether the elements of an array or bytes are all skipped, each element being a
+ * single parameter the plugin does not capture
+ *
+ * @param node: array or bytes node
+ *
+ * @returns true if the parser can jump over the elements
+ */
+static bool is_opaque(const abi_node_t *node) {
+    return node->kind == ABI_BYTES ||
+           (PARSER_NODES[node->child].kind == ABI_WORD && PARSER_NODES[node->child].field == NONE);
+}
+
+/**
+ * @brief Start parsing the parameters of a function
+ *
+ * @param parser: parser to initialize
+ * @param root: index in PARSER_NODES of the parameters list of the function
+ *
+ */
+void parser_init(parser_t *parser, uint8_t root) {
+    memset(parser, 0, sizeof(*parser));
+    parser->offset = SELECTOR_SIZE;
+    offsets_verifier_init(&parser->offsets);
+    push(parser, root);
+}
+
+/**
+ * @brief Get the minimum size of an element of an array
+ *
+ * @param node: array or bytes
+ *
+ * @returns size in parameters, including the offset of a dynamic element
+ */
+static uint32_t element_words(const abi_node_t *node) {
+    if (node->kind == ABI_BYTES) {
+        // the length is already counted in parameters
+        return 1;
+    }
+    const abi_node_t *element = &PARSER_NODES[node->child];
+    return ((element->flags & ABI_DYNAMIC) ? 1 : 0) + element->words;
+}
+
+/**
+ * @brief Check the calldata can hold a call of a function
+ *
+ * @param root: index of the parameters of the function in PARSER_NODES
+ * @param size: calldata size, selector included
+ *
+ * @returns false if the calldata is not a selector followed by parameters, or is too small
+ */
+bool parser_check_size(uint8_t root, uint32_t size) {
+    return size >= SELECTOR_SIZE + (uint32_t) PARSER_NODES[root].words * PARAMETER_LENGTH &&
+           size <= UINT16_MAX && (size - SELECTOR_SIZE) % PARAMETER_LENGTH == 0;
+}
+
+/**
+ * @brief Parse the next parameter of the calldata
+ *
+ * @param parser: parser to update
+ * @param parameter: 32-byte parameter
+ * @param offset: calldata offset of the parameter
+ * @param size: calldata size, the elements of the arrays must fit in it
+ * @param field: set to the parameter to capture, NONE if it can be skipped
+ *
+ * @returns false if the parameter is not the expected one
+ */
+bool parser_parse(parser_t *parser,
+                  const uint8_t *parameter,
+                  uint32_t offset,
+                  uint16_t size,
+                  uint8_t *field) {
+    *field = NONE;
+    if (offset != parser->offset || offset > UINT16_MAX - PARAMETER_LENGTH) {
+        TRACE(TRACE_UNEXPECTED_OFFSET, offset, 0, parser->offset);
+        return false;
+    }
+    if (!settle(parser)) {
+        return false;
+    }
+    if (parser->depth == 0) {
+        TRACE(TRACE_PARAMETER_AFTER_END, offset, 0, 0);
+        return false;
+    }
+
+    parser_frame_t *frame = &parser->frames[parser->depth - 1];
+    const abi_node_t *node = &PARSER_NODES[frame->node];
+    uint8_t child;
+    uint16_t value;
+
+    if (frame->phase == PARSER_LENGTH) {
+        if (!U2BE_from_parameter(parameter, &value)) {
+            TRACE(TRACE_UNSUPPORTED_LENGTH, offset, frame->node, 0);
+            return false;
+        }
+        // bytes are skipped 32 at a time
+        frame->count = (node->kind == ABI_BYTES) ? (value + PARAMETER_LENGTH - 1) / PARAMETER_LENGTH
+                                                 : value;
+        frame->base = offset + PARAMETER_LENGTH;
+        frame->phase = PARSER_HEAD;
+        *field = node->field;
+        // the elements must fit in the rest of the calldata, long lengths are rejected before
+        // their elements are streamed
+        if (frame->base + frame->count * element_words(node) * PARAMETER_LENGTH > size) {
+            TRACE(TRACE_LENGTH_PAST_END, offset, frame->node, value);
+            return false;
+        }
+        if (is_opaque(node)) {
+            // the next parameter is the one following the elements, see `parser_skipping`
+            parser->offset = frame->base + frame->count * PARAMETER_LENGTH;
+            frame->index = frame->count;
+            return true;
+        }
+    } else {
+        if (node->kind == ABI_TUPLE) {
+            child = frame->index;
+            frame->index = PARSER_NODES[child].next;
+        } else {
+            child = node->child;
+            frame->index += 1;
+        }
+        if (node->kind == ABI_BYTES) {
+            // opaque data
+        } else if (PARSER_NODES[child].flags & ABI_DYNAMIC) {
+            if (!U2BE_from_parameter(parameter, &value) ||
+                value > UINT16_MAX - PARAMETER_LENGTH - frame->base) {
+                TRACE(TRACE_UNSUPPORTED_OFFSET, offset, frame->node, 0);
+                return false;
+            }
+            offsets_verifier_announce(&parser->offsets, offset, frame->base + value);
+        } else {
+            *field = PARSER_NODES[child].field;
+        }
+    }
+    parser->offset += PARAMETER_LENGTH;
+    return true;
+}
+
+/**
+ * @brief Get the end of the region the parser jumped over with the last parameter
+ *
+ * @param parser: parser to check
+ * @param offset: calldata offset of the last parameter
+ *
+ * @returns calldata offset of the next parameter to parse, 0 if it is the one following `offset`
+ */
+uint16_t parser_skipping(const parser_t *parser, uint32_t offset) {
+    return (parser->offset > offset + PARAMETER_LENGTH) ? parser->offset : 0;
+}
+
+/**
+ * @brief Check the whole calldata has been parsed and every offset was the expected one
+ *
+ * @param parser: parser to check
+ *
+ * @returns true if the calldata is complete and consistent
+ */
+bool parser_finish(parser_t *parser) {
+    if (!settle(parser) || parser->depth != 0) {
+        TRACE(TRACE_CALLDATA_INCOMPLETE, parser->offset, parser->depth, 0);
+        return false;
+    }
+    if (!offsets_verifier_match(&parser->offsets)) {
+        TRACE(TRACE_OFFSETS_MISMATCH, 0, 0, 0);
+        return false;
+    }
+    return true;
+}
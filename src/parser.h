@@ -0,0 +1,102 @@
+/*******************************************************************************
+ *   Plugin eigenlayer
+ *   (c) 2023 Ledger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "parser_tables.h"
+
+// Kinds of ABI nodes described by the parser tables.
+typedef enum {
+    ABI_WORD = 0,  // any static type encoded in a single parameter
+    ABI_TUPLE,     // struct, parameters list or fixed size array
+    ABI_ARRAY,     // dynamic size array
+    ABI_BYTES,     // bytes or string, skipped
+} abi_kind_t;
+
+// `abi_node_t.flags` bits
+#define ABI_DYNAMIC 0x01  // encoded in the tail of its parent, the head holds its offset
+
+// Index used to mark the end of a list of tuple fields.
+#define PARSER_NO_NODE 0xFF
+
+// One node of the ABI type tree of a function, see `tools/generate_parser_tables.py`.
+typedef struct {
+    uint8_t kind;   // abi_kind_t
+    uint8_t flags;  // ABI_DYNAMIC
+    uint8_t field;  // parameter captured when parsing this node, NONE to skip it
+    uint8_t child;  // first field of a tuple, element of an array
+    uint8_t next;   // next field of the parent tuple, or PARSER_NO_NODE
+    uint8_t head;   // offset of the head of this field in the parent tuple, in parameters
+    uint8_t words;  // minimum size of the encoding of this node (heads and tails), in parameters
+} abi_node_t;
+
+// Number of independent evaluation points used by offsets_verifier_t
+#define OFFSETS_VERIFIER_LANES 2
+
+// Offsets of the dynamic parameters are all announced in the heads of their parents, before the
+// parameters themselves. Instead of storing them, every (head, announced offset) pair and every
+// (head, offset at which the parameter actually starts) pair are folded into two multiset
+// fingerprints, evaluated modulo the Mersenne prime 2^31 - 1 at points drawn at random on the
+// device. Two different sets of n pairs only match with probability at most
+// ((n + 1) / 2^31) ^ OFFSETS_VERIFIER_LANES.
+typedef struct {
+    uint32_t point[OFFSETS_VERIFIER_LANES];
+    uint32_t weight[OFFSETS_VERIFIER_LANES];
+    uint32_t announced[OFFSETS_VERIFIER_LANES];
+    uint32_t observed[OFFSETS_VERIFIER_LANES];
+} offsets_verifier_t;
+
+// What the parser expects next in a tuple or an array.
+typedef enum {
+    PARSER_LENGTH = 0,  // array: the number of elements
+    PARSER_HEAD,        // static parameters and offsets of the dynamic ones
+    PARSER_TAIL,        // dynamic parameters
+} parser_phase_t;
+
+// Position of the parser in a tuple or an array being parsed.
+typedef struct {
+    uint16_t base;   // calldata offset of the first head parameter
+    uint16_t index;  // tuple: next field node, array: next element
+    uint16_t count;  // array: number of elements
+    uint8_t node;    // index of the tuple or array in PARSER_NODES
+    uint8_t phase;   // parser_phase_t
+} parser_frame_t;
+
+typedef struct {
+    parser_frame_t frames[PARSER_MAX_DEPTH];
+    uint8_t depth;
+    uint16_t offset;  // calldata offset of the next parameter
+    offsets_verifier_t offsets;
+} parser_t;
+
+void parser_init(parser_t *parser, uint8_t root);
+bool parser_check_size(uint8_t root, uint32_t size);
+bool parser_parse(parser_t *parser,
+                  const uint8_t *parameter,
+                  uint32_t offset,
+                  uint16_t size,
+                  uint8_t *field);
+uint16_t parser_skipping(const parser_t *parser, uint32_t offset);
+bool parser_finish(parser_t *parser);
+
+void offsets_verifier_init(offsets_verifier_t *verifier);
+void offsets_verifier_announce(offsets_verifier_t *verifier, uint16_t head, uint16_t offset);
+void offsets_verifier_observe(offsets_verifier_t *verifier, uint16_t head, uint16_t offset);
+bool offsets_verifier_match(const offsets_verifier_t *verifier);
+void sequence_digest_fold(const offsets_verifier_t *verifier, uint32_t *digest, uint8_t value);
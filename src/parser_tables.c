@@ -0,0 +1,170 @@
+// Generated by tools/generate_parser_tables.py from tests/abis, do not edit.
+
+#include "plugin.h"
+
+// {kind, flags, field, child, next, head, words}
+const abi_node_t PARSER_NODES[PARSER_NODES_COUNT] = {
+    // 0xe7a050aa depositIntoStrategy
+    // 0: parameters
+    {ABI_TUPLE, 0, NONE, 1, PARSER_NO_NODE, 0, 3},
+    // 1: strategy
+    {ABI_WORD, 0, STRATEGY, PARSER_NO_NODE, 2, 0, 1},
+    // 2: token
+    {ABI_WORD, 0, TOKEN, PARSER_NO_NODE, 3, 1, 1},
+    // 3: amount
+    {ABI_WORD, 0, AMOUNT, PARSER_NO_NODE, PARSER_NO_NODE, 2, 1},
+    // 0xeea9064b delegateTo
+    // 4: parameters
+    {ABI_TUPLE, ABI_DYNAMIC, NONE, 5, PARSER_NO_NODE, 0, 6},
+    // 5: operator
+    {ABI_WORD, 0, OPERATOR, PARSER_NO_NODE, 6, 0, 1},
+    // 6: approverSignatureAndExpiry
+    {ABI_TUPLE, ABI_DYNAMIC, NONE, 7, 9, 1, 3},
+    // 7: approverSignatureAndExpiry.signature
+    {ABI_BYTES, ABI_DYNAMIC, NONE, PARSER_NO_NODE, 8, 0, 1},
+    // 8: approverSignatureAndExpiry.expiry
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, PARSER_NO_NODE, 1, 1},
+    // 9: approverSalt
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, PARSER_NO_NODE, 2, 1},
+    // 0xda8be864 undelegate
+    // 10: parameters
+    {ABI_TUPLE, 0, NONE, 11, PARSER_NO_NODE, 0, 1},
+    // 11: staker
+    {ABI_WORD, 0, STAKER, PARSER_NO_NODE, PARSER_NO_NODE, 0, 1},
+    // 0x0dd8dd02 queueWithdrawals
+    // 12: parameters
+    {ABI_TUPLE, ABI_DYNAMIC, NONE, 13, PARSER_NO_NODE, 0, 2},
+    // 13: queuedWithdrawalParams
+    {ABI_ARRAY, ABI_DYNAMIC, NONE, 14, PARSER_NO_NODE, 0, 1},
+    // 14: queuedWithdrawalParams[]
+    {ABI_TUPLE, ABI_DYNAMIC, NONE, 15, PARSER_NO_NODE, 0, 5},
+    // 15: queuedWithdrawalParams[].strategies
+    {ABI_ARRAY, ABI_DYNAMIC, STRATEGIES_SIZE, 16, 17, 0, 1},
+    // 16: queuedWithdrawalParams[].strategies[]
+    {ABI_WORD, 0, STRATEGY, PARSER_NO_NODE, PARSER_NO_NODE, 0, 1},
+    // 17: queuedWithdrawalParams[].shares
+    {ABI_ARRAY, ABI_DYNAMIC, SHARES_SIZE, 18, 19, 1, 1},
+    // 18: queuedWithdrawalParams[].shares[]
+    {ABI_WORD, 0, SHARE, PARSER_NO_NODE, PARSER_NO_NODE, 0, 1},
+    // 19: queuedWithdrawalParams[].withdrawer
+    {ABI_WORD, 0, WITHDRAWER, PARSER_NO_NODE, PARSER_NO_NODE, 2, 1},
+    // 0x33404396 completeQueuedWithdrawals
+    // 20: parameters
+    {ABI_TUPLE, ABI_DYNAMIC, NONE, 21, PARSER_NO_NODE, 0, 8},
+    // 21: withdrawals
+    {ABI_ARRAY, ABI_DYNAMIC, NONE, 22, 32, 0, 1},
+    // 22: withdrawals[]
+    {ABI_TUPLE, ABI_DYNAMIC, NONE, 23, PARSER_NO_NODE, 0, 9},
+    // 23: withdrawals[].staker
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, 24, 0, 1},
+    // 24: withdrawals[].delegatedTo
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, 25, 1, 1},
+    // 25: withdrawals[].withdrawer
+    {ABI_WORD, 0, WITHDRAWER, PARSER_NO_NODE, 26, 2, 1},
+    // 26: withdrawals[].nonce
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, 27, 3, 1},
+    // 27: withdrawals[].startBlock
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, 28, 4, 1},
+    // 28: withdrawals[].strategies
+    {ABI_ARRAY, ABI_DYNAMIC, STRATEGIES_SIZE, 29, 30, 5, 1},
+    // 29: withdrawals[].strategies[]
+    {ABI_WORD, 0, STRATEGY, PARSER_NO_NODE, PARSER_NO_NODE, 0, 1},
+    // 30: withdrawals[].shares
+    {ABI_ARRAY, ABI_DYNAMIC, SHARES_SIZE, 31, PARSER_NO_NODE, 6, 1},
+    // 31: withdrawals[].shares[]
+    {ABI_WORD, 0, SHARE, PARSER_NO_NODE, PARSER_NO_NODE, 0, 1},
+    // 32: tokens
+    {ABI_ARRAY, ABI_DYNAMIC, TOKENS_SIZE, 33, 35, 1, 1},
+    // 33: tokens[]
+    {ABI_ARRAY, ABI_DYNAMIC, WITHDRAWAL_TOKENS_SIZE, 34, PARSER_NO_NODE, 0, 1},
+    // 34: tokens[][]
+    {ABI_WORD, 0, TOKEN, PARSER_NO_NODE, PARSER_NO_NODE, 0, 1},
+    // 35: middlewareTimesIndexes
+    {ABI_ARRAY, ABI_DYNAMIC, MIDDLEWARE_TIMES_SIZE, 36, 37, 2, 1},
+    // 36: middlewareTimesIndexes[]
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, PARSER_NO_NODE, 0, 1},
+    // 37: receiveAsTokens
+    {ABI_ARRAY, ABI_DYNAMIC, RECEIVE_AS_TOKENS_SIZE, 38, PARSER_NO_NODE, 3, 1},
+    // 38: receiveAsTokens[]
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, PARSER_NO_NODE, 0, 1},
+    // 0x9435bb43 completeQueuedWithdrawals
+    // 39: parameters
+    {ABI_TUPLE, ABI_DYNAMIC, NONE, 40, PARSER_NO_NODE, 0, 6},
+    // 40: withdrawals
+    {ABI_ARRAY, ABI_DYNAMIC, NONE, 41, 51, 0, 1},
+    // 41: withdrawals[]
+    {ABI_TUPLE, ABI_DYNAMIC, NONE, 42, PARSER_NO_NODE, 0, 9},
+    // 42: withdrawals[].staker
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, 43, 0, 1},
+    // 43: withdrawals[].delegatedTo
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, 44, 1, 1},
+    // 44: withdrawals[].withdrawer
+    {ABI_WORD, 0, WITHDRAWER, PARSER_NO_NODE, 45, 2, 1},
+    // 45: withdrawals[].nonce
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, 46, 3, 1},
+    // 46: withdrawals[].startBlock
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, 47, 4, 1},
+    // 47: withdrawals[].strategies
+    {ABI_ARRAY, ABI_DYNAMIC, STRATEGIES_SIZE, 48, 49, 5, 1},
+    // 48: withdrawals[].strategies[]
+    {ABI_WORD, 0, STRATEGY, PARSER_NO_NODE, PARSER_NO_NODE, 0, 1},
+    // 49: withdrawals[].scaledShares
+    {ABI_ARRAY, ABI_DYNAMIC, SHARES_SIZE, 50, PARSER_NO_NODE, 6, 1},
+    // 50: withdrawals[].scaledShares[]
+    {ABI_WORD, 0, SHARE, PARSER_NO_NODE, PARSER_NO_NODE, 0, 1},
+    // 51: tokens
+    {ABI_ARRAY, ABI_DYNAMIC, TOKENS_SIZE, 52, 54, 1, 1},
+    // 52: tokens[]
+    {ABI_ARRAY, ABI_DYNAMIC, WITHDRAWAL_TOKENS_SIZE, 53, PARSER_NO_NODE, 0, 1},
+    // 53: tokens[][]
+    {ABI_WORD, 0, TOKEN, PARSER_NO_NODE, PARSER_NO_NODE, 0, 1},
+    // 54: receiveAsTokens
+    {ABI_ARRAY, ABI_DYNAMIC, RECEIVE_AS_TOKENS_SIZE, 55, PARSER_NO_NODE, 2, 1},
+    // 55: receiveAsTokens[]
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, PARSER_NO_NODE, 0, 1},
+    // 0x3ccc861d processClaim
+    // 56: parameters
+    {ABI_TUPLE, ABI_DYNAMIC, NONE, 57, PARSER_NO_NODE, 0, 14},
+    // 57: claim
+    {ABI_TUPLE, ABI_DYNAMIC, NONE, 58, 72, 0, 12},
+    // 58: claim.rootIndex
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, 59, 0, 1},
+    // 59: claim.earnerIndex
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, 60, 1, 1},
+    // 60: claim.earnerTreeProof
+    {ABI_BYTES, ABI_DYNAMIC, NONE, PARSER_NO_NODE, 61, 2, 1},
+    // 61: claim.earnerLeaf
+    {ABI_TUPLE, 0, NONE, 62, 64, 3, 2},
+    // 62: claim.earnerLeaf.earner
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, 63, 0, 1},
+    // 63: claim.earnerLeaf.earnerTokenRoot
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, PARSER_NO_NODE, 1, 1},
+    // 64: claim.tokenIndices
+    {ABI_ARRAY, ABI_DYNAMIC, NONE, 65, 66, 5, 1},
+    // 65: claim.tokenIndices[]
+    {ABI_WORD, 0, NONE, PARSER_NO_NODE, PARSER_NO_NODE, 0, 1},
+    // 66: claim.tokenTreeProofs
+    {ABI_ARRAY, ABI_DYNAMIC, NONE, 67, 68, 6, 1},
+    // 67: claim.tokenTreeProofs[]
+    {ABI_BYTES, ABI_DYNAMIC, NONE, PARSER_NO_NODE, PARSER_NO_NODE, 0, 1},
+    // 68: claim.tokenLeaves
+    {ABI_ARRAY, ABI_DYNAMIC, NONE, 69, PARSER_NO_NODE, 7, 1},
+    // 69: claim.tokenLeaves[]
+    {ABI_TUPLE, 0, NONE, 70, PARSER_NO_NODE, 0, 2},
+    // 70: claim.tokenLeaves[].token
+    {ABI_WORD, 0, TOKEN, PARSER_NO_NODE, 71, 0, 1},
+    // 71: claim.tokenLeaves[].cumulativeEarnings
+    {ABI_WORD, 0, EARNINGS, PARSER_NO_NODE, PARSER_NO_NODE, 1, 1},
+    // 72: recipient
+    {ABI_WORD, 0, RECIPIENT, PARSER_NO_NODE, PARSER_NO_NODE, 1, 1},
+};
+
+const uint8_t PARSER_ROOTS[SELECTOR_COUNT] = {
+    [DEPOSIT_INTO_STRATEGY] = 0,
+    [DELEGATE_TO] = 4,
+    [UNDELEGATE] = 10,
+    [QUEUE_WITHDRAWAL_PARAMS] = 12,
+    [COMPLETE_QUEUED_WITHDRAWALS] = 20,
+    [COMPLETE_QUEUED_WITHDRAWALS_SLASHING] = 39,
+    [PROCESS_CLAIM] = 56,
+};
@@ -0,0 +1,8 @@
+// Generated by tools/generate_parser_tables.py from tests/abis, do not edit.
+
+#pragma once
+
+// Maximum number of nested tuples and arrays
+#define PARSER_MAX_DEPTH 4
+
+#define PARSER_NODES_COUNT 73
@@ -17,26 +17,57 @@
 
 #pragma once
 
+#include <stddef.h>
 #include <string.h>
 #include <ctype.h>
 #include "cx.h"
 #include "eth_plugin_interface.h"
+#include "parser.h"
+#include "trace.h"
+#include "registry_tables.h"
 
-// All possible selectors of your plugin.
+// All possible selectors of your plugin, sorted by value so that they are binary searched
+// (`tools/generate_parser_tables.py` checks the order and the values against the ABIs).
+// Each selector is declared with:
+//     - its name and value
+//     - the label of its first screen
+//     - its number of screens, before the ones added by `finalize`
+//     - `finalize`, the function of handle_finalize.c checking the parsed transaction and adding
+//       its variable screens
+//     - `handler`, the name of its `handle_<handler>` functions in handle_provide_parameter.c and
+//       handle_query_contract_ui.c
+// Versions of a function whose ABIs only differ in layout, such as completeQueuedWithdrawals
+// before and after the slashing release, share their `finalize` and `handler`: only their
+// generated tables differ.
+// The parameters to parse are described by the tables generated from the ABIs, see
+// `PARSER_ROOTS`.
 // A Xmacro below will create for you:
 //     - an enum named selector_t with every NAME
-//     - a map named SELECTORS associating each NAME with it's value
-#define SELECTORS_LIST(X)                  \
-    X(DEPOSIT_INTO_STRATEGY, 0xe7a050aa)   \
-    X(DELEGATE_TO, 0xeea9064b)             \
-    X(UNDELEGATE, 0xda8be864)              \
-    X(QUEUE_WITHDRAWAL_PARAMS, 0x0dd8dd02) \
-    X(COMPLETE_QUEUED_WITHDRAWALS, 0x33404396)
-
-// Xmacro helpers to define the enum and map
+//     - the tables SELECTORS, SELECTOR_LABELS and SELECTOR_SCREENS indexed by selector_t
+#define SELECTORS_LIST(X)                                                                        \
+    X(QUEUE_WITHDRAWAL_PARAMS, 0x0dd8dd02, "Queued Withdrawal", 1,                                \
+      finalize_withdrawals, queue_withdrawal)                                                     \
+    X(COMPLETE_QUEUED_WITHDRAWALS, 0x33404396, "Complete Queued Withdrawals", 1,                  \
+      finalize_completed_withdrawals, complete_queued_withdrawals)                                \
+    X(PROCESS_CLAIM, 0x3ccc861d, "Claim Rewards", 1,                                              \
+      finalize_claim, process_claim)                                                              \
+    X(COMPLETE_QUEUED_WITHDRAWALS_SLASHING, 0x9435bb43, "Complete Queued Withdrawals", 1,         \
+      finalize_completed_withdrawals, complete_queued_withdrawals)                                \
+    X(UNDELEGATE, 0xda8be864, "Undelegate", 1,                                                    \
+      finalize_fixed, undelegate)                                                                 \
+    X(DEPOSIT_INTO_STRATEGY, 0xe7a050aa, "Deposit into Strategy", 2,                              \
+      finalize_fixed, deposit_into_strategy)                                                      \
+    X(DELEGATE_TO, 0xeea9064b, "Delegate to", 1,                                                  \
+      finalize_fixed, delegate_to)
+
+// Xmacro helpers to define the enum and the tables, the callbacks define their own to dispatch
+// to the functions of each selector. The dispatch is a switch, not a table of function
+// pointers, so that `make stack-usage` can still bound the stack depth of the callbacks.
 // Do not modify !
-#define TO_ENUM(selector_name, selector_id)  selector_name,
-#define TO_VALUE(selector_name, selector_id) selector_id,
+#define TO_ENUM(name, selector, label, screens, finalize, handler)    name,
+#define TO_VALUE(name, selector, label, screens, finalize, handler)   selector,
+#define TO_LABEL(name, selector, label, screens, finalize, handler)   label,
+#define TO_SCREENS(name, selector, label, screens, finalize, handler) screens,
 
 // This enum will be automatically expanded to hold all selector names.
 // The value SELECTOR_COUNT can be used to get the number of defined selectors
@@ -45,89 +76,100 @@ typedef enum selector_e {
     SELECTORS_LIST(TO_ENUM) SELECTOR_COUNT,
 } selector_t;
 
-// This array will be automatically expanded to map all selector_t names with the correct value.
+// These arrays will be automatically expanded to map all selector_t names with their value,
+// label and screens.
 // Do not modify !
 extern const uint32_t SELECTORS[SELECTOR_COUNT];
+extern const char *const SELECTOR_LABELS[SELECTOR_COUNT];
+extern const uint8_t SELECTOR_SCREENS[SELECTOR_COUNT];
 
-#define STRATEGIES_COUNT           11
-#define UNKNOWN_TOKEN              15
-#define UNKNOWN_STRATEGY           15
+// Registry indexes are 8-bit, the registries are generated from tools/registry.json, see
+// `tools/generate_registry.py`.
+#define UNKNOWN_TOKEN              0xFF
+#define UNKNOWN_STRATEGY           0xFF
 #define ERC20_DECIMALS             18
-#define MAX_DISPLAYABLE_STRATEGIES 32  // > STRATEGIES_COUNT
+#if defined(TARGET_STAX) || defined(TARGET_FLEX)
+// Large screens show as many strategies as fit in a message of this length (the Ethereum app
+// gives at least 79 bytes), separated by STRATEGIES_SEPARATOR, if they share their title.
+#define STRATEGIES_PAGE_LENGTH 78
+#else
+// One strategy per screen
+#define STRATEGIES_PAGE_LENGTH 0
+#endif
+#define STRATEGIES_SEPARATOR ", "
+// Longest text of a strategy: the 78 digits of a 256-bit total, its decimal point, a space and
+// the ticker
+#define STRATEGY_TEXT_LENGTH (78 + 2 + MAX_TICKER_LEN)
+// Bytes of the run-length encoded strategies list of a withdrawal of queueWithdrawals and
+// completeQueuedWithdrawals, 6 strategies that do not repeat
+#define STRATEGIES_LIST_LENGTH 6
+// numScreens counts the strategies and the withdrawer on 8 bits
+#define MAX_STRATEGIES (UINT8_MAX - 1)
+// Marks a run in the strategies list, it can not be a registry index
+#define STRATEGIES_RUN 0xFE
+// Folded in the pairing digests at the start of each withdrawal, it can not be a registry index
+#define WITHDRAWAL_MARKER 0xFE
 // ADDRESS_STR_LEN is 0x + addr + \0
 #define ADDRESS_STR_LEN 43
 
-extern const char strategy_addresses[STRATEGIES_COUNT][ADDRESS_STR_LEN];
-extern const char token_addresses[STRATEGIES_COUNT][ADDRESS_STR_LEN];
-extern const char tickers[STRATEGIES_COUNT][MAX_TICKER_LEN];
+// The registry indexes, below STRATEGIES_MAX_COUNT, stop before the reserved values, as checked
+// by tools/generate_registry.py
+_Static_assert(STRATEGIES_MAX_COUNT <= STRATEGIES_RUN && STRATEGIES_RUN < UNKNOWN_STRATEGY,
+               "registry indexes are too narrow");
+_Static_assert(STRATEGIES_MAX_COUNT <= WITHDRAWAL_MARKER && WITHDRAWAL_MARKER < UNKNOWN_STRATEGY,
+               "registry indexes are too narrow");
+_Static_assert(UNKNOWN_TOKEN == UNKNOWN_STRATEGY,
+               "unknown tokens must pair with unknown strategies");
+
+// Strategies supported on a chain.
+// Registry addresses are stored in binary so they can be matched in place against the
+// 32-byte calldata parameters, without formatting them first. Both address tables are sorted, a
+// strategy is found by binary search in `strategy_addresses`, its index giving its ticker, a token
+// in `token_addresses`, `token_strategies` giving the index of its strategy.
+typedef struct {
+    uint64_t chain_id;
+    const uint8_t (*strategy_addresses)[ADDRESS_LENGTH];
+    const char (*tickers)[MAX_TICKER_LEN];
+    const uint8_t (*token_addresses)[ADDRESS_LENGTH];
+    const uint8_t *token_strategies;
+    uint8_t count;
+} registry_t;
 
-// Enumeration used to parse the smart contract data.
+// Registry of each chain, the last one is empty and used for the other chains.
+extern const registry_t REGISTRIES[REGISTRIES_COUNT + 1];
+
+// Parameters captured by the plugin, see `tools/generate_parser_tables.py`.
 typedef enum {
-    STRATEGY = 0,
+    NONE = 0,  // skipped parameter
+    STRATEGY,
     TOKEN,
     AMOUNT,
     STAKER,
     OPERATOR,
-    NONE,
-    DATA_OFFSET,
-    SHARE,
     WITHDRAWER,
-    TUPLE_SIZE,
-    SHARES_OFFSET,
-    TUPLE_OFFSET,
-    WITHDRAWER_OFFSET,
-    WITHDRAWER_SIZE,
-    SHARES_SIZE,
-    STRATEGY_OFFSET,
-    STRATEGY_SIZE,
-    WITHDRAWALS_OFFSET,
-    TOKEN_TUPLE_SIZE,
-    TOKEN_OFFSET,
-    TOKEN_SIZE,
-    DELEGATE,
-    TOKEN_ELEMENT_OFFSET,
-    SIGNATURE_OFFSET,
-    APPROVER_SALT,
-    SIGNATURE_SIG_OFFSET,
-    SIGNATURE_EXPIRACY,
-    SIGNATURE_LENGTH,
-    SIGNATURE_PACKETS,
-    WITHDRAWALS_SIZE,
-    WITHDRAWALS_ITEM_OFFSET,
-    MIDDLEWARE_TIMES_OFFSET,
-    MIDDLEWARE_TIMES_SIZE,
-    RECEIVE_AS_TOKENS_OFFSET,
     TOKENS_SIZE,
-    TOKEN_OFFSET_ITEMS,
-    TOKENS_ITEM_SIZE,
-    TOKENS_ITEM_ELEMENT,
-    NONCE,
-    START_BLOCK,
-    RECEIVE_AS_TOKEN_SIZE,
-    MIDDLEWARE_TIMES_ITEM,
-    RECEIVE_AS_TOKEN_ITEM,
-    UNEXPECTED_PARAMETER,
+    WITHDRAWAL_TOKENS_SIZE,
+    MIDDLEWARE_TIMES_SIZE,
+    RECEIVE_AS_TOKENS_SIZE,
+    STRATEGIES_SIZE,
+    SHARES_SIZE,
+    SHARE,
+    RECIPIENT,
+    EARNINGS,
 } parameter;
 
+// Parser tables of each selector, generated from tests/abis.
+extern const abi_node_t PARSER_NODES[PARSER_NODES_COUNT];
+extern const uint8_t PARSER_ROOTS[SELECTOR_COUNT];
+
 typedef struct {
     uint8_t value[ADDRESS_LENGTH];
 } address_t;
 
 typedef struct {
-    uint16_t len;
-    uint8_t text[PARAMETER_LENGTH + 1];
-    bool ellipsis;
-} name_t;
-
-typedef struct {
-    uint8_t value[INT256_LENGTH];
-    bool ellipsis;
-} bytes32_t;
-
-typedef struct {
-    int strategy;
-    int token;
-    bytes32_t amount;
+    uint8_t strategy;
+    uint8_t token;
+    uint8_t amount[INT256_LENGTH];
 } deposit_into_strategy_t;
 
 typedef struct {
@@ -136,73 +178,98 @@ typedef struct {
 
 typedef struct {
     address_t operator;
-    uint16_t signature_packet_count;
 } delegate_to_t;
 
+// A list of amounts holds entries of a registry index, then the size of its amount and the
+// amount, big endian without its leading zero bytes, or AMOUNT_NONE and no amount. The amounts
+// are exact 256-bit values, only stored on the bytes they need.
+#define AMOUNT_HEADER_LENGTH 2
+#define AMOUNT_NONE          0xFF
+// Bytes of the list of share totals of queueWithdrawals and completeQueuedWithdrawals, the room
+// left in the context: 4 totals below 2^72 (4.7e3 tokens of 18 decimals), or 22 distinct
+// strategies without total
+#define SHARE_TOTALS_LENGTH 45
+
+// Strategies of queueWithdrawals and completeQueuedWithdrawals. They are displayed one screen per
+// distinct strategy in order of appearance, with the total of its shares. A strategy whose total
+// does not fit in `share_totals` is displayed flagged, without total: the totals of the previous
+// strategies are dropped, last first, to make room for a new one. A batch is only rejected when
+// its distinct strategies do not fit without total either. The unknown strategies share one
+// screen, without total.
 typedef struct {
-    uint8_t prev_checksum[CX_KECCAK_256_SIZE];
-    uint32_t new_offset;
-} checksum_offset_params_t;
+    uint8_t count;          // number of strategies in the batch
+    uint8_t length;         // bytes of `list` used
+    uint8_t last;           // index in `list` of the last entry
+    uint8_t first;          // index in the batch of the first strategy of the current withdrawal
+    uint8_t shares_count;   // number of shares parsed for the current withdrawal
+    uint8_t totals_length;  // bytes of `share_totals` used
+    uint8_t unlisted : 1;   // strategies of the current withdrawal did not fit in `list`
+    // strategies of the current withdrawal, which its shares are added to. Each entry is a
+    // registry index or UNKNOWN_STRATEGY, optionally followed by STRATEGIES_RUN and the number of
+    // times the strategy repeats. The strategies that do not fit are displayed without total.
+    uint8_t list[STRATEGIES_LIST_LENGTH];
+    // list of amounts of the distinct strategies, UNKNOWN_STRATEGY for the unknown ones
+    uint8_t share_totals[SHARE_TOTALS_LENGTH];
+} strategies_t;
+
+// Titles of the strategy screens, a page only holds strategies with the same title
+typedef enum {
+    STRATEGY_TOTAL,     // known strategy with its share total
+    STRATEGY_NO_TOTAL,  // known strategy whose total is not shown
+    STRATEGY_UNKNOWN,   // the strategies missing from the registry
+} strategy_title_t;
 
 typedef struct {
-    // for parsing
-    uint16_t queued_withdrawals_count;
-    uint16_t current_item_count;
-    uint16_t shares_array_offset;
-    uint8_t qwithdrawals_offsets_checksum_preview[CX_KECCAK_256_SIZE];
-    uint8_t qwithdrawals_offsets_checksum_value[CX_KECCAK_256_SIZE];
-
-    // for display
-    char withdrawer[ADDRESS_STR_LEN];
-    uint8_t strategies_count;
-    // list of strategies indexes **INCREMENTED BY 1** to display in the UI
-    // 0 is reserved for end of array
-    // UNKNOWN_LR_STRATEGY is used to display the "unknown" strategy
-    // assumptions:
-    // (i) in practice, we should not encounter more than
-    //      LR_STRATEGIES_COUNT +~ a few potential unsupported
-    //      strategies in the plugin. So * 3 should be a good enough buffer.
-    // (ii) in practice there should not be more than (2 ** 8) - 2 known strategies
-    uint8_t strategies[MAX_DISPLAYABLE_STRATEGIES];
+    // formatted when displayed
+    uint8_t withdrawer[ADDRESS_LENGTH];
+    strategies_t strategies;
 } queue_withdrawal_t;
 
-// must be size of MAX_DISPLAYABLE_STRATEGIES
 typedef struct {
-    uint32_t bits;
-} bitfield;
+    // -- pairing of the tokens with the strategies, see `sequence_digest_fold`. Each withdrawal
+    // folds WITHDRAWAL_MARKER, then its strategies or the strategies of its tokens, in order,
+    // UNKNOWN_STRATEGY for the unknown ones.
+    uint32_t strategies_digest;  // withdrawals
+    uint32_t tokens_digest;      // tokens arrays
 
-typedef struct {
-    // -- utils
-    uint16_t parent_item_count;
-    uint16_t current_item_count;
     // -- total values
-    uint16_t relegations_count;
     uint8_t withdrawals_count;
-    uint16_t strategies_count;
-    uint16_t tokens_count;
-    // -- offset verification
-    uint16_t tokens_offset;
-    uint16_t middlewareTimesIndexes_offset;
-    uint16_t receiveAsTokens_offset;
-    uint16_t cached_offset;
-    uint8_t withdrawals_offsets_checksum_preview[CX_KECCAK_256_SIZE];
-    uint8_t withdrawals_offsets_checksum_value[CX_KECCAK_256_SIZE];
+    uint8_t tokens_withdrawals;  // withdrawals with a non-empty tokens array
 
     // -- display
     uint8_t withdrawer[ADDRESS_LENGTH];
-    // list of strategies indexes **INCREMENTED BY 1** to display in the UI
-    // UNKNOWN_LR_STRATEGY is used to display the "unknown" strategy
-    // assumptions:
-    // (i) in practice, we should not encounter more than
-    //      LR_STRATEGIES_COUNT +~ a few potential unsupported
-    //      strategies in the plugin. So * 3 should be a good enough buffer.
-    // (ii) in practice there should not be more than (2 ** 4) - 2 known strategies
-    // (iii) the first 4 bytes are the withdrawal index, the next 4 bytes are the strategy index
-    uint8_t strategies[MAX_DISPLAYABLE_STRATEGIES];
+    strategies_t strategies;
 } complete_queued_withdrawals_t;
 
+// Bytes of the list of earnings of processClaim, the room left in the context
+#define CLAIM_EARNINGS_LENGTH 64
+
+// Token leaves of processClaim, one screen per leaf of a known token in order of appearance with
+// its cumulative earnings, exact on 256 bits, then one for the unknown tokens if any. A leaf
+// whose earnings do not fit in `earnings` is flagged, without earnings, and the leaves that do not
+// fit without earnings either are counted on a last screen. The proofs are skipped.
+typedef struct {
+    address_t recipient;
+    uint8_t earnings_length;  // bytes of `earnings` used
+    uint8_t token;            // registry index of the token of the current leaf or UNKNOWN_TOKEN
+    uint8_t hidden;           // leaves of known tokens that do not fit in `earnings`
+    uint8_t unknown : 1;      // a token leaf is not in the registry
+    // list of amounts of the leaves of known tokens, see AMOUNT_HEADER_LENGTH
+    uint8_t earnings[CLAIM_EARNINGS_LENGTH];
+} process_claim_t;
+
 // Shared global memory with Ethereum app. Must be at most 5 * 32 bytes.
 typedef struct context_s {
+    // For parsing data.
+    parser_t parser;           // Position in the ABI tree of the selector.
+    uint16_t size;             // Calldata size, checked against the array lengths.
+    uint8_t go_to_offset : 1;  // If set, the parameters are skipped without being parsed until
+                               // the next parameter of the parser is reached.
+
+    // For both parsing and display.
+    uint8_t selectorIndex : 5;  // selector_t
+    uint8_t registry : 2;       // index in REGISTRIES, selected from the chain id
+
     // For display
     union {
         deposit_into_strategy_t deposit_into_strategy;
@@ -210,17 +277,82 @@ typedef struct context_s {
         delegate_to_t delegate_to;
         queue_withdrawal_t queue_withdrawal;
         complete_queued_withdrawals_t complete_queued_withdrawals;
+        process_claim_t process_claim;
     } tx;
+} context_t;
 
-    // For parsing data.
-    uint8_t next_param;  // Set to be the next param we expect to parse.
-    uint16_t offset;     // Offset at which the array or struct starts.
-    bool go_to_offset;   // If set, will force the parsing to iterate through parameters until
-                         // `offset` is reached.
+// Size of the context shared with the Ethereum app, see ASSERT_SIZEOF_PLUGIN_CONTEXT.
+#define PLUGIN_CONTEXT_MAX_SIZE (5 * INT256_LENGTH)
+// Bytes of the context used for parsing, the display data of each selector gets the rest.
+#define PLUGIN_CONTEXT_PARSING_SIZE offsetof(context_t, tx)
+#define ASSERT_SIZEOF_TX(type)                                                            \
+    _Static_assert(PLUGIN_CONTEXT_PARSING_SIZE + sizeof(type) <= PLUGIN_CONTEXT_MAX_SIZE, \
+                   #type " does not fit in the plugin context")
 
-    // For both parsing and display.
-    selector_t selectorIndex;
-} context_t;
+ASSERT_SIZEOF_TX(deposit_into_strategy_t);
+ASSERT_SIZEOF_TX(undelegate_t);
+ASSERT_SIZEOF_TX(delegate_to_t);
+ASSERT_SIZEOF_TX(queue_withdrawal_t);
+ASSERT_SIZEOF_TX(complete_queued_withdrawals_t);
+ASSERT_SIZEOF_TX(process_claim_t);
+_Static_assert(SELECTOR_COUNT <= (1 << 5), "selectorIndex is too narrow");
+_Static_assert(REGISTRIES_COUNT < (1 << 2), "registry is too narrow");
+
+/**
+ * @brief Get the strategy registry of the chain of the transaction
+ *
+ * @param context: context of the plugin
+ *
+ * @returns registry selected by handle_init_contract
+ */
+static inline const registry_t *context_registry(const context_t *context) {
+    return &REGISTRIES[context->registry];
+}
+
+bool strategies_add(strategies_t *strategies, uint8_t strategy);
+uint8_t strategies_get(const strategies_t *strategies, uint8_t index);
+bool strategies_start_withdrawal(strategies_t *strategies, uint16_t length);
+bool strategies_check_shares_length(const strategies_t *strategies, uint16_t length);
+bool strategies_add_share(strategies_t *strategies, const uint8_t *parameter);
+uint8_t strategies_screens(const strategies_t *strategies, const registry_t *registry);
+bool strategies_page(const strategies_t *strategies,
+                     const registry_t *registry,
+                     uint8_t page,
+                     uint8_t *first,
+                     uint8_t *size);
+strategy_title_t strategies_title(const strategies_t *strategies, uint8_t index);
+bool strategies_text(const strategies_t *strategies,
+                     const registry_t *registry,
+                     uint8_t index,
+                     char *text,
+                     size_t size);
+const char *strategies_ticker(const registry_t *registry, uint8_t strategy);
+
+uint8_t amount_size(const uint8_t *value, uint8_t size);
+uint8_t amounts_entry(const uint8_t *list, uint8_t length, uint8_t index);
+uint8_t amounts_count(const uint8_t *list, uint8_t length);
+uint8_t amounts_find(const uint8_t *list, uint8_t length, uint8_t index);
+bool amounts_append(uint8_t *list,
+                    uint8_t *length,
+                    uint8_t capacity,
+                    uint8_t index,
+                    const uint8_t *value,
+                    uint8_t size);
+bool amounts_set(uint8_t *list,
+                 uint8_t *length,
+                 uint8_t capacity,
+                 uint8_t offset,
+                 const uint8_t *value,
+                 uint8_t size);
+const uint8_t *amounts_value(const uint8_t *list, uint8_t offset, uint8_t *size);
+
+void rewards_add_token(process_claim_t *claim, uint8_t token);
+void rewards_add_earnings(process_claim_t *claim, const uint8_t *parameter);
+uint8_t rewards_screens(const process_claim_t *claim);
+const uint8_t *rewards_leaf(const process_claim_t *claim,
+                            uint8_t index,
+                            uint8_t *token,
+                            uint8_t *size);
 
 // Check if the context structure will fit in the RAM section ETH will prepare for us
 // Do not remove!
@@ -0,0 +1,293 @@
+// Generated by tools/generate_registry.py from tools/registry.json, do not edit.
+
+#include "plugin.h"
+
+// Addresses are written as big endian (64, 64, 32)-bit integers, so that the compiler can check
+// the order of the tables the lookups binary search.
+#define ADDRESS_BYTES(...) ADDRESS_BYTES_(__VA_ARGS__)
+#define ADDRESS_BYTES_(a0, a1, a2) BYTES64(a0), BYTES64(a1), BYTES32(a2)
+#define BYTES64(v)                 BYTES32((v) >> 32), BYTES32(v)
+#define BYTES32(v) \
+    (uint8_t) ((v) >> 24), (uint8_t) ((v) >> 16), (uint8_t) ((v) >> 8), (uint8_t) (v)
+#define ADDRESS_BEFORE(...) ADDRESS_BEFORE_(__VA_ARGS__)
+#define ADDRESS_BEFORE_(a0, a1, a2, b0, b1, b2) \
+    ((a0) < (b0) || ((a0) == (b0) && ((a1) < (b1) || ((a1) == (b1) && (a2) < (b2)))))
+
+// mainnet, chain id 1
+
+// 0: swETH 0x0Fe4F44beE93503346A3Ac9EE5A26b130a5796d6
+#define MAINNET_STRATEGY_0 0x0fe4f44bee935033ULL, 0x46a3ac9ee5a26b13ULL, 0x0a5796d6ULL
+// 1: ankrETH 0x13760F50a9d7377e4F20CB8CF9e4c26586c658ff
+#define MAINNET_STRATEGY_1 0x13760f50a9d7377eULL, 0x4f20cb8cf9e4c265ULL, 0x86c658ffULL
+// 2: rETH 0x1BeE69b7dFFfA4E2d53C2a2Df135C388AD25dCD2
+#define MAINNET_STRATEGY_2 0x1bee69b7dfffa4e2ULL, 0xd53c2a2df135c388ULL, 0xad25dcd2ULL
+// 3: mETH 0x298aFB19A105D59E74658C4C334Ff360BadE6dd2
+#define MAINNET_STRATEGY_3 0x298afb19a105d59eULL, 0x74658c4c334ff360ULL, 0xbade6dd2ULL
+// 4: cbETH 0x54945180dB7943c0ed0FEE7EdaB2Bd24620256bc
+#define MAINNET_STRATEGY_4 0x54945180db7943c0ULL, 0xed0fee7edab2bd24ULL, 0x620256bcULL
+// 5: osETH 0x57ba429517c3473B6d34CA9aCd56c0e735b94c02
+#define MAINNET_STRATEGY_5 0x57ba429517c3473bULL, 0x6d34ca9acd56c0e7ULL, 0x35b94c02ULL
+// 6: wBETH 0x7CA911E83dabf90C90dD3De5411a10F1A6112184
+#define MAINNET_STRATEGY_6 0x7ca911e83dabf90cULL, 0x90dd3de5411a10f1ULL, 0xa6112184ULL
+// 7: sfrxETH 0x8CA7A5d6f3acd3A7A8bC468a8CD0FB14B6BD28b6
+#define MAINNET_STRATEGY_7 0x8ca7a5d6f3acd3a7ULL, 0xa8bc468a8cd0fb14ULL, 0xb6bd28b6ULL
+// 8: stETH 0x93c4b944D05dfe6df7645A86cd2206016c51564D
+#define MAINNET_STRATEGY_8 0x93c4b944d05dfe6dULL, 0xf7645a86cd220601ULL, 0x6c51564dULL
+// 9: ETHx 0x9d7eD45EE2E8FC5482fa2428f15C971e6369011d
+#define MAINNET_STRATEGY_9 0x9d7ed45ee2e8fc54ULL, 0x82fa2428f15c971eULL, 0x6369011dULL
+// 10: OETH 0xa4C637e0F704745D182e4D38cAb7E7485321d059
+#define MAINNET_STRATEGY_10 0xa4c637e0f704745dULL, 0x182e4d38cab7e748ULL, 0x5321d059ULL
+// OETH token 0x856c4Efb76C1D1AE02e20CEB03A2A6a08b0b8dC3
+#define MAINNET_TOKEN_0 0x856c4efb76c1d1aeULL, 0x02e20ceb03a2a6a0ULL, 0x8b0b8dc3ULL
+// wBETH token 0xa2E3356610840701BDf5611a53974510Ae27E2e1
+#define MAINNET_TOKEN_1 0xa2e3356610840701ULL, 0xbdf5611a53974510ULL, 0xae27e2e1ULL
+// ETHx token 0xA35b1B31Ce002FBF2058D22F30f95D405200A15b
+#define MAINNET_TOKEN_2 0xa35b1b31ce002fbfULL, 0x2058d22f30f95d40ULL, 0x5200a15bULL
+// sfrxETH token 0xac3E018457B222d93114458476f3E3416Abbe38F
+#define MAINNET_TOKEN_3 0xac3e018457b222d9ULL, 0x3114458476f3e341ULL, 0x6abbe38fULL
+// rETH token 0xae78736Cd615f374D3085123A210448E74Fc6393
+#define MAINNET_TOKEN_4 0xae78736cd615f374ULL, 0xd3085123a210448eULL, 0x74fc6393ULL
+// stETH token 0xae7ab96520DE3A18E5e111B5EaAb095312D7fE84
+#define MAINNET_TOKEN_5 0xae7ab96520de3a18ULL, 0xe5e111b5eaab0953ULL, 0x12d7fe84ULL
+// cbETH token 0xBe9895146f7AF43049ca1c1AE358B0541Ea49704
+#define MAINNET_TOKEN_6 0xbe9895146f7af430ULL, 0x49ca1c1ae358b054ULL, 0x1ea49704ULL
+// mETH token 0xd5F7838F5C461fefF7FE49ea5ebaF7728bB0ADfa
+#define MAINNET_TOKEN_7 0xd5f7838f5c461fefULL, 0xf7fe49ea5ebaf772ULL, 0x8bb0adfaULL
+// ankrETH token 0xE95A203B1a91a908F9B9CE46459d101078c2c3cb
+#define MAINNET_TOKEN_8 0xe95a203b1a91a908ULL, 0xf9b9ce46459d1010ULL, 0x78c2c3cbULL
+// osETH token 0xf1C9acDc66974dFB6dEcB12aA385b9cD01190E38
+#define MAINNET_TOKEN_9 0xf1c9acdc66974dfbULL, 0x6decb12aa385b9cdULL, 0x01190e38ULL
+// swETH token 0xf951E335afb289353dc249e82926178EaC7DEd78
+#define MAINNET_TOKEN_10 0xf951e335afb28935ULL, 0x3dc249e82926178eULL, 0xac7ded78ULL
+
+// Strategies sorted by address, the registry index of a strategy is its rank
+static const uint8_t mainnet_strategy_addresses[11][ADDRESS_LENGTH] = {
+    {ADDRESS_BYTES(MAINNET_STRATEGY_0)},
+    {ADDRESS_BYTES(MAINNET_STRATEGY_1)},
+    {ADDRESS_BYTES(MAINNET_STRATEGY_2)},
+    {ADDRESS_BYTES(MAINNET_STRATEGY_3)},
+    {ADDRESS_BYTES(MAINNET_STRATEGY_4)},
+    {ADDRESS_BYTES(MAINNET_STRATEGY_5)},
+    {ADDRESS_BYTES(MAINNET_STRATEGY_6)},
+    {ADDRESS_BYTES(MAINNET_STRATEGY_7)},
+    {ADDRESS_BYTES(MAINNET_STRATEGY_8)},
+    {ADDRESS_BYTES(MAINNET_STRATEGY_9)},
+    {ADDRESS_BYTES(MAINNET_STRATEGY_10)},
+};
+
+static const char mainnet_tickers[11][MAX_TICKER_LEN] = {
+    "swETH",
+    "ankrETH",
+    "rETH",
+    "mETH",
+    "cbETH",
+    "osETH",
+    "wBETH",
+    "sfrxETH",
+    "stETH",
+    "ETHx",
+    "OETH",
+};
+
+// Underlying tokens sorted by address
+static const uint8_t mainnet_token_addresses[11][ADDRESS_LENGTH] = {
+    {ADDRESS_BYTES(MAINNET_TOKEN_0)},
+    {ADDRESS_BYTES(MAINNET_TOKEN_1)},
+    {ADDRESS_BYTES(MAINNET_TOKEN_2)},
+    {ADDRESS_BYTES(MAINNET_TOKEN_3)},
+    {ADDRESS_BYTES(MAINNET_TOKEN_4)},
+    {ADDRESS_BYTES(MAINNET_TOKEN_5)},
+    {ADDRESS_BYTES(MAINNET_TOKEN_6)},
+    {ADDRESS_BYTES(MAINNET_TOKEN_7)},
+    {ADDRESS_BYTES(MAINNET_TOKEN_8)},
+    {ADDRESS_BYTES(MAINNET_TOKEN_9)},
+    {ADDRESS_BYTES(MAINNET_TOKEN_10)},
+};
+
+// Registry index of the strategy of each token
+static const uint8_t mainnet_token_strategies[11] = {10, 6, 9, 7, 2, 8, 4, 3, 1, 5, 0};
+
+_Static_assert(ADDRESS_BEFORE(MAINNET_STRATEGY_0, MAINNET_STRATEGY_1),
+               "mainnet_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_STRATEGY_1, MAINNET_STRATEGY_2),
+               "mainnet_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_STRATEGY_2, MAINNET_STRATEGY_3),
+               "mainnet_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_STRATEGY_3, MAINNET_STRATEGY_4),
+               "mainnet_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_STRATEGY_4, MAINNET_STRATEGY_5),
+               "mainnet_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_STRATEGY_5, MAINNET_STRATEGY_6),
+               "mainnet_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_STRATEGY_6, MAINNET_STRATEGY_7),
+               "mainnet_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_STRATEGY_7, MAINNET_STRATEGY_8),
+               "mainnet_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_STRATEGY_8, MAINNET_STRATEGY_9),
+               "mainnet_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_STRATEGY_9, MAINNET_STRATEGY_10),
+               "mainnet_strategy_addresses must be sorted by address");
+
+_Static_assert(ADDRESS_BEFORE(MAINNET_TOKEN_0, MAINNET_TOKEN_1),
+               "mainnet_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_TOKEN_1, MAINNET_TOKEN_2),
+               "mainnet_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_TOKEN_2, MAINNET_TOKEN_3),
+               "mainnet_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_TOKEN_3, MAINNET_TOKEN_4),
+               "mainnet_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_TOKEN_4, MAINNET_TOKEN_5),
+               "mainnet_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_TOKEN_5, MAINNET_TOKEN_6),
+               "mainnet_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_TOKEN_6, MAINNET_TOKEN_7),
+               "mainnet_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_TOKEN_7, MAINNET_TOKEN_8),
+               "mainnet_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_TOKEN_8, MAINNET_TOKEN_9),
+               "mainnet_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(MAINNET_TOKEN_9, MAINNET_TOKEN_10),
+               "mainnet_token_addresses must be sorted by address");
+
+// holesky, chain id 17000
+
+// 0: lsETH 0x05037A81BD7B4C9E0F7B430f1F2A22c31a2FD943
+#define HOLESKY_STRATEGY_0 0x05037a81bd7b4c9eULL, 0x0f7b430f1f2a22c3ULL, 0x1a2fd943ULL
+// 1: ETHx 0x31B6F59e1627cEfC9fA174aD03859fC337666af7
+#define HOLESKY_STRATEGY_1 0x31b6f59e1627cefcULL, 0x9fa174ad03859fc3ULL, 0x37666af7ULL
+// 2: rETH 0x3A8fBdf9e77DFc25d09741f51d3E181b25d0c4E0
+#define HOLESKY_STRATEGY_2 0x3a8fbdf9e77dfc25ULL, 0xd09741f51d3e181bULL, 0x25d0c4e0ULL
+// 3: osETH 0x46281E3B7fDcACdBa44CADf069a94a588Fd4C6Ef
+#define HOLESKY_STRATEGY_3 0x46281e3b7fdcacdbULL, 0xa44cadf069a94a58ULL, 0x8fd4c6efULL
+// 4: cbETH 0x70EB4D3c164a6B4A5f908D4FBb5a9cAffb66bAB6
+#define HOLESKY_STRATEGY_4 0x70eb4d3c164a6b4aULL, 0x5f908d4fbb5a9cafULL, 0xfb66bab6ULL
+// 5: ankrETH 0x7673a47463F80c6a3553Db9E54c8cDcd5313d0ac
+#define HOLESKY_STRATEGY_5 0x7673a47463f80c6aULL, 0x3553db9e54c8cdcdULL, 0x5313d0acULL
+// 6: stETH 0x7D704507b76571a51d9caE8AdDAbBFd0ba0e63d3
+#define HOLESKY_STRATEGY_6 0x7d704507b76571a5ULL, 0x1d9cae8addabbfd0ULL, 0xba0e63d3ULL
+// 7: WETH 0x80528D6e9A2BAbFc766965E0E26d5aB08D9CFaF9
+#define HOLESKY_STRATEGY_7 0x80528d6e9a2babfcULL, 0x766965e0e26d5ab0ULL, 0x8d9cfaf9ULL
+// 8: sfrxETH 0x9281ff96637710Cd9A5CacCe9c6FAD8C9F54631c
+#define HOLESKY_STRATEGY_8 0x9281ff96637710cdULL, 0x9a5cacce9c6fad8cULL, 0x9f54631cULL
+// 9: mETH 0xaccc5A86732BE85b5012e8614AF237801636F8e5
+#define HOLESKY_STRATEGY_9 0xaccc5a86732be85bULL, 0x5012e8614af23780ULL, 0x1636f8e5ULL
+// lsETH token 0x1d8b30cC38Dba8aBce1ac29Ea27d9cFd05379A09
+#define HOLESKY_TOKEN_0 0x1d8b30cc38dba8abULL, 0xce1ac29ea27d9cfdULL, 0x05379a09ULL
+// stETH token 0x3F1c547b21f65e10480dE3ad8E19fAAC46C95034
+#define HOLESKY_TOKEN_1 0x3f1c547b21f65e10ULL, 0x480de3ad8e19faacULL, 0x46c95034ULL
+// rETH token 0x7322c24752f79c05FFD1E2a6FCB97020C1C264F1
+#define HOLESKY_TOKEN_2 0x7322c24752f79c05ULL, 0xffd1e2a6fcb97020ULL, 0xc1c264f1ULL
+// cbETH token 0x8720095Fa5739Ab051799211B146a2EEE4Dd8B37
+#define HOLESKY_TOKEN_3 0x8720095fa5739ab0ULL, 0x51799211b146a2eeULL, 0xe4dd8b37ULL
+// ankrETH token 0x8783C9C904e1bdC87d9168AE703c8481E8a477Fd
+#define HOLESKY_TOKEN_4 0x8783c9c904e1bdc8ULL, 0x7d9168ae703c8481ULL, 0xe8a477fdULL
+// WETH token 0x94373a4919B3240D86eA41593D5eBa789FEF3848
+#define HOLESKY_TOKEN_5 0x94373a4919b3240dULL, 0x86ea41593d5eba78ULL, 0x9fef3848ULL
+// sfrxETH token 0xa63f56985F9C7F3bc9fFc5685535649e0C1a55f3
+#define HOLESKY_TOKEN_6 0xa63f56985f9c7f3bULL, 0xc9ffc5685535649eULL, 0x0c1a55f3ULL
+// ETHx token 0xB4F5fc289a778B80392b86fa70A7111E5bE0F859
+#define HOLESKY_TOKEN_7 0xb4f5fc289a778b80ULL, 0x392b86fa70a7111eULL, 0x5be0f859ULL
+// mETH token 0xe3C063B1BEe9de02eb28352b55D49D85514C67FF
+#define HOLESKY_TOKEN_8 0xe3c063b1bee9de02ULL, 0xeb28352b55d49d85ULL, 0x514c67ffULL
+// osETH token 0xF603c5A3F774F05d4D848A9bB139809790890864
+#define HOLESKY_TOKEN_9 0xf603c5a3f774f05dULL, 0x4d848a9bb1398097ULL, 0x90890864ULL
+
+// Strategies sorted by address, the registry index of a strategy is its rank
+static const uint8_t holesky_strategy_addresses[10][ADDRESS_LENGTH] = {
+    {ADDRESS_BYTES(HOLESKY_STRATEGY_0)},
+    {ADDRESS_BYTES(HOLESKY_STRATEGY_1)},
+    {ADDRESS_BYTES(HOLESKY_STRATEGY_2)},
+    {ADDRESS_BYTES(HOLESKY_STRATEGY_3)},
+    {ADDRESS_BYTES(HOLESKY_STRATEGY_4)},
+    {ADDRESS_BYTES(HOLESKY_STRATEGY_5)},
+    {ADDRESS_BYTES(HOLESKY_STRATEGY_6)},
+    {ADDRESS_BYTES(HOLESKY_STRATEGY_7)},
+    {ADDRESS_BYTES(HOLESKY_STRATEGY_8)},
+    {ADDRESS_BYTES(HOLESKY_STRATEGY_9)},
+};
+
+static const char holesky_tickers[10][MAX_TICKER_LEN] = {
+    "lsETH",
+    "ETHx",
+    "rETH",
+    "osETH",
+    "cbETH",
+    "ankrETH",
+    "stETH",
+    "WETH",
+    "sfrxETH",
+    "mETH",
+};
+
+// Underlying tokens sorted by address
+static const uint8_t holesky_token_addresses[10][ADDRESS_LENGTH] = {
+    {ADDRESS_BYTES(HOLESKY_TOKEN_0)},
+    {ADDRESS_BYTES(HOLESKY_TOKEN_1)},
+    {ADDRESS_BYTES(HOLESKY_TOKEN_2)},
+    {ADDRESS_BYTES(HOLESKY_TOKEN_3)},
+    {ADDRESS_BYTES(HOLESKY_TOKEN_4)},
+    {ADDRESS_BYTES(HOLESKY_TOKEN_5)},
+    {ADDRESS_BYTES(HOLESKY_TOKEN_6)},
+    {ADDRESS_BYTES(HOLESKY_TOKEN_7)},
+    {ADDRESS_BYTES(HOLESKY_TOKEN_8)},
+    {ADDRESS_BYTES(HOLESKY_TOKEN_9)},
+};
+
+// Registry index of the strategy of each token
+static const uint8_t holesky_token_strategies[10] = {0, 6, 2, 4, 5, 7, 8, 1, 9, 3};
+
+_Static_assert(ADDRESS_BEFORE(HOLESKY_STRATEGY_0, HOLESKY_STRATEGY_1),
+               "holesky_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(HOLESKY_STRATEGY_1, HOLESKY_STRATEGY_2),
+               "holesky_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(HOLESKY_STRATEGY_2, HOLESKY_STRATEGY_3),
+               "holesky_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(HOLESKY_STRATEGY_3, HOLESKY_STRATEGY_4),
+               "holesky_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(HOLESKY_STRATEGY_4, HOLESKY_STRATEGY_5),
+               "holesky_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(HOLESKY_STRATEGY_5, HOLESKY_STRATEGY_6),
+               "holesky_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(HOLESKY_STRATEGY_6, HOLESKY_STRATEGY_7),
+               "holesky_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(HOLESKY_STRATEGY_7, HOLESKY_STRATEGY_8),
+               "holesky_strategy_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(HOLESKY_STRATEGY_8, HOLESKY_STRATEGY_9),
+               "holesky_strategy_addresses must be sorted by address");
+
+_Static_assert(ADDRESS_BEFORE(HOLESKY_TOKEN_0, HOLESKY_TOKEN_1),
+               "holesky_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(HOLESKY_TOKEN_1, HOLESKY_TOKEN_2),
+               "holesky_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(HOLESKY_TOKEN_2, HOLESKY_TOKEN_3),
+               "holesky_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(HOLESKY_TOKEN_3, HOLESKY_TOKEN_4),
+               "holesky_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(HOLESKY_TOKEN_4, HOLESKY_TOKEN_5),
+               "holesky_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(HOLESKY_TOKEN_5, HOLESKY_TOKEN_6),
+               "holesky_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(HOLESKY_TOKEN_6, HOLESKY_TOKEN_7),
+               "holesky_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(HOLESKY_TOKEN_7, HOLESKY_TOKEN_8),
+               "holesky_token_addresses must be sorted by address");
+_Static_assert(ADDRESS_BEFORE(HOLESKY_TOKEN_8, HOLESKY_TOKEN_9),
+               "holesky_token_addresses must be sorted by address");
+
+// {chain_id, strategy_addresses, tickers, token_addresses, token_strategies, count}
+const registry_t REGISTRIES[REGISTRIES_COUNT + 1] = {
+    {1,
+     mainnet_strategy_addresses,
+     mainnet_tickers,
+     mainnet_token_addresses,
+     mainnet_token_strategies,
+     11},
+    {17000,
+     holesky_strategy_addresses,
+     holesky_tickers,
+     holesky_token_addresses,
+     holesky_token_strategies,
+     10},
+    // other chains
+    {0, NULL, NULL, NULL, NULL, 0},
+};
@@ -0,0 +1,9 @@
+// Generated by tools/generate_registry.py from tools/registry.json, do not edit.
+
+#pragma once
+
+// Number of chains with a registry
+#define REGISTRIES_COUNT 2
+
+// Size of the biggest registry
+#define STRATEGIES_MAX_COUNT 11
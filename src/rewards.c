@@ -0,0 +1,87 @@
+#include "plugin.h"
+
+/**
+ * @brief Start a token leaf of processClaim, its earnings come next
+ *
+ * @param claim: token leaves of the claim
+ * @param token: registry index of the strategy of the token or UNKNOWN_TOKEN
+ *
+ */
+void rewards_add_token(process_claim_t *claim, uint8_t token) {
+    claim->token = token;
+    if (token == UNKNOWN_TOKEN) {
+        // unknown tokens can not be told apart, they share a screen
+        claim->unknown = 1;
+    }
+}
+
+/**
+ * @brief Keep the cumulative earnings of the current token leaf. A token may have several
+ * leaves: each one claims its cumulative earnings minus what was already claimed, including by
+ * the previous leaves of the token, so they are displayed leaf by leaf and never summed.
+ *
+ * @param claim: token leaves of the claim
+ * @param parameter: 256-bit earnings
+ *
+ */
+void rewards_add_earnings(process_claim_t *claim, const uint8_t *parameter) {
+    if (claim->token == UNKNOWN_TOKEN) {
+        return;
+    }
+    if (amounts_append(claim->earnings,
+                       &claim->earnings_length,
+                       sizeof(claim->earnings),
+                       claim->token,
+                       parameter,
+                       INT256_LENGTH)) {
+        return;
+    }
+    TRACE(TRACE_NO_ROOM_FOR_EARNINGS, 0, claim->token, claim->earnings_length);
+    if (!amounts_append(claim->earnings,
+                        &claim->earnings_length,
+                        sizeof(claim->earnings),
+                        claim->token,
+                        NULL,
+                        0) &&
+        claim->hidden < UINT8_MAX) {
+        claim->hidden += 1;
+    }
+}
+
+/**
+ * @brief Get the number of token screens of a claim
+ *
+ * @param claim: token leaves of the claim
+ *
+ * @returns one screen per leaf of a known token, one for the unknown tokens and one for the
+ * leaves that do not fit
+ */
+uint8_t rewards_screens(const process_claim_t *claim) {
+    return amounts_count(claim->earnings, claim->earnings_length) + claim->unknown +
+           (claim->hidden > 0);
+}
+
+/**
+ * @brief Get a token leaf of the claim and its cumulative earnings, the leaves of known tokens
+ * come in order of appearance, then the unknown tokens
+ *
+ * @param claim: token leaves of the claim
+ * @param index: index of the token screen, less than rewards_screens without the hidden leaves
+ * @param token: set to the registry index of the strategy of the token or UNKNOWN_TOKEN
+ * @param size: set to the bytes of the earnings
+ *
+ * @returns big endian earnings, NULL if they are not displayed
+ */
+const uint8_t *rewards_leaf(const process_claim_t *claim,
+                            uint8_t index,
+                            uint8_t *token,
+                            uint8_t *size) {
+    uint8_t offset = amounts_entry(claim->earnings, claim->earnings_length, index);
+
+    if (offset == claim->earnings_length) {
+        *token = UNKNOWN_TOKEN;
+        return NULL;
+    }
+    *token = claim->earnings[offset];
+    return amounts_value(claim->earnings, offset, size);
+}
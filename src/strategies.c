@@ -0,0 +1,441 @@
+#include "plugin.h"
+
+// A run of the list: the registry index of the strategy, STRATEGIES_RUN, then the number of
+// times the strategy repeats
+#define RUN_LENGTH 3
+
+/**
+ * @brief Display a distinct strategy without total
+ *
+ * @param strategies: strategies of the batch
+ * @param offset: offset of the strategy in `share_totals`
+ *
+ */
+static void drop_total(strategies_t *strategies, uint8_t offset) {
+    // an entry only shrinks without its total
+    amounts_set(strategies->share_totals,
+                &strategies->totals_length,
+                sizeof(strategies->share_totals),
+                offset,
+                NULL,
+                0);
+}
+
+/**
+ * @brief Drop the total of the last distinct strategy which still has one
+ *
+ * @param strategies: strategies of the batch
+ *
+ * @returns false if no distinct strategy has a total
+ */
+static bool drop_last_total(strategies_t *strategies) {
+    uint8_t size;
+
+    for (uint8_t rank = amounts_count(strategies->share_totals, strategies->totals_length);
+         rank > 0;
+         rank--) {
+        uint8_t offset =
+            amounts_entry(strategies->share_totals, strategies->totals_length, rank - 1);
+        if (amounts_value(strategies->share_totals, offset, &size) != NULL) {
+            TRACE(TRACE_NO_ROOM_FOR_TOTALS, 0, strategies->share_totals[offset], strategies->count);
+            drop_total(strategies, offset);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Add a strategy to the distinct strategies of the batch
+ *
+ * @param strategies: strategies of the batch
+ * @param strategy: registry index of the strategy or UNKNOWN_STRATEGY
+ * @param totaled: whether the shares of the strategy can be summed
+ *
+ * @returns false if the distinct strategies do not fit in the context
+ */
+static bool add_distinct(strategies_t *strategies, uint8_t strategy, bool totaled) {
+    uint8_t offset = amounts_find(strategies->share_totals, strategies->totals_length, strategy);
+    // a total of 0, the unknown strategies can not be summed together
+    const uint8_t zero = 0;
+    const uint8_t *total = (totaled && strategy != UNKNOWN_STRATEGY) ? &zero : NULL;
+
+    if (offset < strategies->totals_length) {
+        if (total == NULL) {
+            drop_total(strategies, offset);
+        }
+        return true;
+    }
+    if (amounts_append(strategies->share_totals,
+                       &strategies->totals_length,
+                       sizeof(strategies->share_totals),
+                       strategy,
+                       total,
+                       sizeof(zero))) {
+        return true;
+    }
+    TRACE(TRACE_NO_ROOM_FOR_TOTALS, 0, strategy, strategies->count);
+    // every strategy is displayed, the totals of the previous ones make room for it
+    while (!amounts_append(strategies->share_totals,
+                           &strategies->totals_length,
+                           sizeof(strategies->share_totals),
+                           strategy,
+                           NULL,
+                           0)) {
+        if (!drop_last_total(strategies)) {
+            TRACE(TRACE_TOO_MANY_STRATEGIES, 0, 0, strategies->count);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Tell whether an entry of the list is a run, a strategy repeated several times
+ *
+ * @param strategies: strategies of the batch
+ * @param offset: index in the list of the entry
+ *
+ * @returns true for a run, false for a single strategy
+ */
+static bool is_run(const strategies_t *strategies, uint8_t offset) {
+    // an entry starts with a registry index, which can not be STRATEGIES_RUN
+    return offset + RUN_LENGTH <= strategies->length &&
+           strategies->list[offset + 1] == STRATEGIES_RUN;
+}
+
+/**
+ * @brief Get the number of bytes the list grows by when a strategy is appended
+ *
+ * @param strategies: strategies of the batch
+ * @param strategy: registry index of the strategy or UNKNOWN_STRATEGY
+ * @param extend: set if the strategy extends the last entry of the list
+ *
+ * @returns number of bytes
+ */
+static uint8_t list_growth(const strategies_t *strategies, uint8_t strategy, bool *extend) {
+    // a strategy repeating the last entry extends it into a run
+    bool run = is_run(strategies, strategies->last);
+    *extend = strategies->length > 0 && strategies->list[strategies->last] == strategy &&
+              (!run || strategies->list[strategies->last + 2] < UINT8_MAX);
+    return !*extend ? 1 : run ? 0 : RUN_LENGTH - 1;
+}
+
+/**
+ * @brief Append a strategy of the current withdrawal to the list, and add it to the distinct
+ * strategies
+ *
+ * @param strategies: strategies of the batch
+ * @param strategy: registry index of the strategy or UNKNOWN_STRATEGY
+ *
+ * @returns false if the batch has too many strategies to be displayed
+ */
+bool strategies_add(strategies_t *strategies, uint8_t strategy) {
+    if (strategies->count >= MAX_STRATEGIES) {
+        TRACE(TRACE_TOO_MANY_STRATEGIES, 0, 0, strategies->count);
+        return false;
+    }
+    bool extend;
+    uint8_t growth = list_growth(strategies, strategy, &extend);
+
+    if (!strategies->unlisted && strategies->length + growth > sizeof(strategies->list)) {
+        // the next strategies of the withdrawal can not be paired with their shares either
+        TRACE(TRACE_LIST_FULL, 0, strategy, strategies->count);
+        strategies->unlisted = 1;
+    }
+    if (!add_distinct(strategies, strategy, !strategies->unlisted)) {
+        return false;
+    }
+    strategies->count += 1;
+    if (strategies->unlisted) {
+        return true;
+    }
+
+    if (!extend) {
+        strategies->last = strategies->length;
+        strategies->list[strategies->length++] = strategy;
+    } else if (!is_run(strategies, strategies->last)) {
+        strategies->list[strategies->length++] = STRATEGIES_RUN;
+        strategies->list[strategies->length++] = 2;
+    } else {
+        strategies->list[strategies->last + 2] += 1;
+    }
+    return true;
+}
+
+/**
+ * @brief Get a strategy of the current withdrawal from the list
+ *
+ * @param strategies: strategies of the batch
+ * @param index: index of the strategy in the withdrawal
+ *
+ * @returns registry index of the strategy, UNKNOWN_STRATEGY if it is unknown or not in the list
+ */
+static uint8_t withdrawal_strategy(const strategies_t *strategies, uint8_t index) {
+    uint8_t offset = 0;
+
+    while (offset < strategies->length) {
+        bool run = is_run(strategies, offset);
+        uint8_t repeat = run ? strategies->list[offset + 2] : 1;
+        if (index < repeat) {
+            return strategies->list[offset];
+        }
+        index -= repeat;
+        offset += run ? RUN_LENGTH : 1;
+    }
+    return UNKNOWN_STRATEGY;
+}
+
+/**
+ * @brief Start the strategies array of a new withdrawal, its shares come next
+ *
+ * @param strategies: strategies of the batch
+ * @param length: length of the strategies array
+ *
+ * @returns false if the batch would have too many strategies, before they are parsed
+ */
+bool strategies_start_withdrawal(strategies_t *strategies, uint16_t length) {
+    if (length > MAX_STRATEGIES - strategies->count) {
+        TRACE(TRACE_TOO_MANY_STRATEGIES, 0, 0, strategies->count + length);
+        return false;
+    }
+    // the shares of the previous withdrawals are already summed
+    strategies->first = strategies->count;
+    strategies->shares_count = 0;
+    strategies->length = 0;
+    strategies->last = 0;
+    strategies->unlisted = 0;
+    return true;
+}
+
+/**
+ * @brief Check the shares array of the current withdrawal has one share per strategy
+ *
+ * @param strategies: strategies of the batch
+ * @param length: length of the shares array
+ *
+ * @returns true if the lengths match
+ */
+bool strategies_check_shares_length(const strategies_t *strategies, uint16_t length) {
+    if (length != strategies->count - strategies->first) {
+        TRACE(TRACE_UNEXPECTED_SHARES_LENGTH, 0, 0, length);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Add the shares of a strategy of the current withdrawal to its 256-bit total
+ *
+ * @param strategies: strategies of the batch
+ * @param parameter: 256-bit shares
+ *
+ * @returns false if there are more shares than strategies in the withdrawal
+ */
+bool strategies_add_share(strategies_t *strategies, const uint8_t *parameter) {
+    if (strategies->first + strategies->shares_count >= strategies->count) {
+        TRACE(TRACE_UNEXPECTED_SHARE, 0, 0, 0);
+        return false;
+    }
+    uint8_t strategy = withdrawal_strategy(strategies, strategies->shares_count++);
+    uint8_t offset = amounts_find(strategies->share_totals, strategies->totals_length, strategy);
+    uint8_t size;
+    const uint8_t *total = (offset < strategies->totals_length)
+                               ? amounts_value(strategies->share_totals, offset, &size)
+                               : NULL;
+
+    if (total == NULL) {
+        // unknown, unlisted, or already displayed without total
+        return true;
+    }
+
+    // 256-bit big endian addition
+    uint8_t sum[INT256_LENGTH] = {0};
+    uint16_t carry = 0;
+    memcpy(sum + sizeof(sum) - size, total, size);
+    for (int i = sizeof(sum) - 1; i >= 0; i--) {
+        carry += sum[i] + parameter[i];
+        sum[i] = (uint8_t) carry;
+        carry >>= 8;
+    }
+    if (carry != 0) {
+        TRACE(TRACE_SHARES_TOTAL_OVERFLOW, 0, strategy, 0);
+        drop_total(strategies, offset);
+    } else if (!amounts_set(strategies->share_totals,
+                            &strategies->totals_length,
+                            sizeof(strategies->share_totals),
+                            offset,
+                            sum,
+                            sizeof(sum))) {
+        TRACE(TRACE_NO_ROOM_FOR_TOTALS, 0, strategy, strategies->count);
+        drop_total(strategies, offset);
+    }
+    return true;
+}
+
+/**
+ * @brief Get the ticker displayed for a strategy
+ *
+ * @param registry: registry of the chain of the transaction
+ * @param strategy: registry index of the strategy or UNKNOWN_STRATEGY
+ *
+ * @returns ticker of the strategy, NULL if the index is invalid
+ */
+const char *strategies_ticker(const registry_t *registry, uint8_t strategy) {
+    if (strategy == UNKNOWN_STRATEGY) {
+        return "UNKNOWN";
+    }
+    if (strategy >= registry->count) {
+        return NULL;
+    }
+    return registry->tickers[strategy];
+}
+
+/**
+ * @brief Get a distinct strategy of the batch and its share total, in order of appearance
+ *
+ * @param strategies: strategies of the batch
+ * @param index: index of the distinct strategy
+ * @param strategy: set to the registry index of the strategy or UNKNOWN_STRATEGY
+ * @param size: set to the bytes of the total
+ *
+ * @returns big endian total, NULL if the strategy is displayed without total
+ */
+static const uint8_t *strategies_distinct(const strategies_t *strategies,
+                                          uint8_t index,
+                                          uint8_t *strategy,
+                                          uint8_t *size) {
+    uint8_t offset = amounts_entry(strategies->share_totals, strategies->totals_length, index);
+
+    *strategy = strategies->share_totals[offset];
+    return amounts_value(strategies->share_totals, offset, size);
+}
+
+/**
+ * @brief Get the title of a distinct strategy of the batch
+ *
+ * @param strategies: strategies of the batch
+ * @param index: index of the distinct strategy
+ *
+ * @returns title of the strategy
+ */
+strategy_title_t strategies_title(const strategies_t *strategies, uint8_t index) {
+    uint8_t strategy;
+    uint8_t size;
+
+    if (strategies_distinct(strategies, index, &strategy, &size) != NULL) {
+        return STRATEGY_TOTAL;
+    }
+    return (strategy == UNKNOWN_STRATEGY) ? STRATEGY_UNKNOWN : STRATEGY_NO_TOTAL;
+}
+
+/**
+ * @brief Write the text of a distinct strategy of the batch, its share total or its ticker
+ *
+ * @param strategies: strategies of the batch
+ * @param registry: registry of the chain of the transaction
+ * @param index: index of the distinct strategy
+ * @param text: buffer to write the text to
+ * @param size: bytes of the buffer
+ *
+ * @returns false if the strategy can not be displayed
+ */
+bool strategies_text(const strategies_t *strategies,
+                     const registry_t *registry,
+                     uint8_t index,
+                     char *text,
+                     size_t size) {
+    uint8_t strategy;
+    uint8_t total_size;
+    const uint8_t *total = strategies_distinct(strategies, index, &strategy, &total_size);
+    const char *ticker = strategies_ticker(registry, strategy);
+
+    if (ticker == NULL) {
+        return false;
+    }
+    if (total == NULL) {
+        strlcpy(text, ticker, size);
+        return true;
+    }
+    return amountToString(total, total_size, ERC20_DECIMALS, ticker, text, size);
+}
+
+/**
+ * @brief Get the number of distinct strategies displayed on a page: as many strategies with the
+ * title of the first one as fit in STRATEGIES_PAGE_LENGTH, and at least one
+ *
+ * @param strategies: strategies of the batch
+ * @param registry: registry of the chain of the transaction
+ * @param first: index of the first distinct strategy of the page
+ *
+ * @returns number of strategies on the page, 0 past the last strategy
+ */
+static uint8_t page_size(const strategies_t *strategies,
+                         const registry_t *registry,
+                         uint8_t first) {
+    uint8_t count = amounts_count(strategies->share_totals, strategies->totals_length);
+    char text[STRATEGY_TEXT_LENGTH];
+    size_t length = 0;
+    uint8_t size = 0;
+
+    while (first + size < count) {
+        if (size > 0) {
+            length += sizeof(STRATEGIES_SEPARATOR) - 1;
+            if (length > STRATEGIES_PAGE_LENGTH ||
+                strategies_title(strategies, first + size) != strategies_title(strategies, first)) {
+                break;
+            }
+        }
+        if (!strategies_text(strategies, registry, first + size, text, sizeof(text))) {
+            text[0] = '\0';
+        }
+        if (size > 0 && length + strlen(text) > STRATEGIES_PAGE_LENGTH) {
+            break;
+        }
+        length += strlen(text);
+        size += 1;
+    }
+    return size;
+}
+
+/**
+ * @brief Get the distinct strategies displayed on a page
+ *
+ * @param strategies: strategies of the batch
+ * @param registry: registry of the chain of the transaction
+ * @param page: index of the page
+ * @param first: set to the index of the first distinct strategy of the page
+ * @param size: set to the number of strategies on the page
+ *
+ * @returns false if there is no such page
+ */
+bool strategies_page(const strategies_t *strategies,
+                     const registry_t *registry,
+                     uint8_t page,
+                     uint8_t *first,
+                     uint8_t *size) {
+    *first = 0;
+    *size = page_size(strategies, registry, 0);
+    for (; page > 0 && *size > 0; page--) {
+        *first += *size;
+        *size = page_size(strategies, registry, *first);
+    }
+    return *size > 0;
+}
+
+/**
+ * @brief Get the number of screens needed to display the strategies
+ *
+ * @param strategies: strategies of the batch
+ * @param registry: registry of the chain of the transaction
+ *
+ * @returns number of pages of distinct strategies, the unknown ones counting as one
+ */
+uint8_t strategies_screens(const strategies_t *strategies, const registry_t *registry) {
+    uint8_t pages = 0;
+
+    for (uint8_t first = 0, size; (size = page_size(strategies, registry, first)) > 0; pages++) {
+        first += size;
+    }
+    return pages;
+}
@@ -0,0 +1,79 @@
+#include "plugin.h"
+
+#if TRACE_LEVEL > TRACE_LEVEL_NONE
+
+#ifdef HAVE_PRINTF
+#define TO_TRACE_NAME(name, level, category) #name,
+static const char *const TRACE_NAMES[TRACE_EVENT_COUNT] = {TRACE_EVENTS(TO_TRACE_NAME)};
+#endif
+
+#define TO_TRACE_EVENT_LEVEL(name, level, category) level,
+static const uint8_t TRACE_EVENT_LEVELS[TRACE_EVENT_COUNT] = {TRACE_EVENTS(TO_TRACE_EVENT_LEVEL)};
+
+// Ring buffer of the records, `trace_next` is the slot of the next one.
+static trace_record_t trace_records[TRACE_RECORDS];
+static uint8_t trace_next;
+static uint8_t trace_count;
+
+_Static_assert(TRACE_RECORDS > 0 && TRACE_RECORDS <= UINT8_MAX, "TRACE_RECORDS is too large");
+
+/**
+ * @brief Record an event, see TRACE
+ *
+ * @param event: event to record
+ * @param offset: calldata offset of the parameter, 0 if none
+ * @param arg: small argument of the event
+ * @param value: argument of the event
+ */
+void trace_record(trace_event_t event, uint16_t offset, uint8_t arg, uint32_t value) {
+    trace_record_t *record = &trace_records[trace_next];
+
+    record->event = event;
+    record->arg = arg;
+    record->offset = offset;
+    record->value = value;
+    trace_next = (trace_next + 1) % TRACE_RECORDS;
+    if (trace_count < TRACE_RECORDS) {
+        trace_count++;
+    }
+    if (TRACE_EVENT_LEVELS[event] == TRACE_LEVEL_ERROR) {
+        trace_dump();
+    }
+}
+
+/**
+ * @brief Print the records with PRINTF, oldest first, and empty the buffer
+ */
+void trace_dump(void) {
+#ifdef HAVE_PRINTF
+    uint8_t slot = (trace_next + TRACE_RECORDS - trace_count) % TRACE_RECORDS;
+
+    PRINTF("Trace, %d records:\n", trace_count);
+    for (; trace_count > 0; trace_count--) {
+        const trace_record_t *record = &trace_records[slot];
+        PRINTF("  %s offset %d arg %d value %u\n",
+               TRACE_NAMES[record->event],
+               record->offset,
+               record->arg,
+               record->value);
+        slot = (slot + 1) % TRACE_RECORDS;
+    }
+#else
+    // PRINTF is a no-op, the records are dropped
+    trace_count = 0;
+#endif
+}
+
+#else
+
+void trace_record(trace_event_t event, uint16_t offset, uint8_t arg, uint32_t value) {
+    (void) event;
+    (void) offset;
+    (void) arg;
+    (void) value;
+}
+
+void trace_dump(void) {
+}
+
+#endif
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ *   Plugin eigenlayer
+ *   (c) 2023 Ledger
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ ********************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+// Trace levels, an event is recorded when its level is at most TRACE_LEVEL.
+#define TRACE_LEVEL_NONE  0
+#define TRACE_LEVEL_ERROR 1  // the transaction is rejected
+#define TRACE_LEVEL_INFO  2  // fallbacks, such as share totals that can not be displayed
+#define TRACE_LEVEL_DEBUG 3  // every parameter and strategy
+
+// Trace categories, an event is recorded when its category is in TRACE_CATEGORIES.
+#define TRACE_DISPATCH 0x01  // callbacks and parameters of the selectors
+#define TRACE_OFFSETS  0x02  // ABI parser and offsets verification
+#define TRACE_LOOKUPS  0x04  // registry lookups and strategies list
+#define TRACE_UI       0x08  // screens
+
+// Set with `make TRACE_LEVEL=3 TRACE_CATEGORIES=0x03`. Debug builds only record the errors by
+// default, and release builds nothing: every TRACE then compiles to nothing.
+#ifndef TRACE_LEVEL
+#ifdef HAVE_PRINTF
+#define TRACE_LEVEL TRACE_LEVEL_ERROR
+#else
+#define TRACE_LEVEL TRACE_LEVEL_NONE
+#endif
+#endif
+
+#ifndef TRACE_CATEGORIES
+#define TRACE_CATEGORIES (TRACE_DISPATCH | TRACE_OFFSETS | TRACE_LOOKUPS | TRACE_UI)
+#endif
+
+// Records kept in the ring buffer, the oldest ones are overwritten.
+#ifndef TRACE_RECORDS
+#define TRACE_RECORDS 32
+#endif
+
+// Events of the plugin with their level and category, the arguments of their records follow.
+#define TRACE_EVENTS(X)                                                                  \
+    /* offset of the parameter, value: its last 4 bytes */                              \
+    X(TRACE_PARAMETER, TRACE_LEVEL_DEBUG, TRACE_DISPATCH)                               \
+    /* value: selector */                                                               \
+    X(TRACE_UNKNOWN_SELECTOR, TRACE_LEVEL_ERROR, TRACE_DISPATCH)                        \
+    /* value: size of the context given by the Ethereum app */                          \
+    X(TRACE_CONTEXT_TOO_SMALL, TRACE_LEVEL_ERROR, TRACE_DISPATCH)                       \
+    /* value: calldata size */                                                          \
+    X(TRACE_UNEXPECTED_CALLDATA_SIZE, TRACE_LEVEL_ERROR, TRACE_DISPATCH)                \
+    /* arg: selector index */                                                           \
+    X(TRACE_UNSUPPORTED_SELECTOR, TRACE_LEVEL_ERROR, TRACE_DISPATCH)                    \
+    /* arg: field */                                                                    \
+    X(TRACE_UNSUPPORTED_FIELD, TRACE_LEVEL_ERROR, TRACE_DISPATCH)                       \
+    /* offset of the withdrawer */                                                      \
+    X(TRACE_UNEXPECTED_WITHDRAWER, TRACE_LEVEL_ERROR, TRACE_DISPATCH)                   \
+    /* offset of the length, arg: withdrawals, value: length */                         \
+    X(TRACE_UNEXPECTED_ARRAY_LENGTH, TRACE_LEVEL_ERROR, TRACE_DISPATCH)                 \
+    /* arg: non-empty tokens arrays, value: withdrawals */                              \
+    X(TRACE_TOKENS_PARTIAL, TRACE_LEVEL_ERROR, TRACE_DISPATCH)                          \
+    /* arg: non-empty tokens arrays, value: strategies */                               \
+    X(TRACE_TOKENS_MISMATCH, TRACE_LEVEL_ERROR, TRACE_DISPATCH)                         \
+    /* offset of the parameter, value: end of the skipped region */                     \
+    X(TRACE_SKIPPED_PAST_OFFSET, TRACE_LEVEL_ERROR, TRACE_OFFSETS)                      \
+    /* value: end of the skipped region */                                              \
+    X(TRACE_CALLDATA_ENDS_BEFORE_OFFSET, TRACE_LEVEL_ERROR, TRACE_OFFSETS)              \
+    /* offset of the parameter, value: offset of the skipped region end */              \
+    X(TRACE_SKIP, TRACE_LEVEL_DEBUG, TRACE_OFFSETS)                                     \
+    /* offset of the parameter, arg: ABI node */                                        \
+    X(TRACE_MAX_DEPTH, TRACE_LEVEL_ERROR, TRACE_OFFSETS)                                \
+    /* offset of the parameter, value: expected offset */                               \
+    X(TRACE_UNEXPECTED_OFFSET, TRACE_LEVEL_ERROR, TRACE_OFFSETS)                        \
+    /* offset of the parameter */                                                       \
+    X(TRACE_PARAMETER_AFTER_END, TRACE_LEVEL_ERROR, TRACE_OFFSETS)                      \
+    /* offset of the length, arg: ABI node */                                           \
+    X(TRACE_UNSUPPORTED_LENGTH, TRACE_LEVEL_ERROR, TRACE_OFFSETS)                       \
+    /* offset of the length, arg: ABI node, value: length */                            \
+    X(TRACE_LENGTH_PAST_END, TRACE_LEVEL_ERROR, TRACE_OFFSETS)                          \
+    /* offset of the head, arg: ABI node */                                             \
+    X(TRACE_UNSUPPORTED_OFFSET, TRACE_LEVEL_ERROR, TRACE_OFFSETS)                       \
+    /* offset of the next parameter expected, arg: depth */                             \
+    X(TRACE_CALLDATA_INCOMPLETE, TRACE_LEVEL_ERROR, TRACE_OFFSETS)                      \
+    X(TRACE_OFFSETS_MISMATCH, TRACE_LEVEL_ERROR, TRACE_OFFSETS)                         \
+    /* arg: length of the chain id, value: chain id if it fits */                       \
+    X(TRACE_NO_REGISTRY, TRACE_LEVEL_INFO, TRACE_LOOKUPS)                               \
+    /* offset of the strategy, arg: registry index, value: strategies */                \
+    X(TRACE_STRATEGY, TRACE_LEVEL_DEBUG, TRACE_LOOKUPS)                                 \
+    /* arg: registry index, value: strategies */                                        \
+    X(TRACE_NO_ROOM_FOR_TOTALS, TRACE_LEVEL_INFO, TRACE_LOOKUPS)                        \
+    /* arg: registry index, value: strategies */                                        \
+    X(TRACE_LIST_FULL, TRACE_LEVEL_INFO, TRACE_LOOKUPS)                                 \
+    /* arg: registry index */                                                           \
+    X(TRACE_SHARES_TOTAL_OVERFLOW, TRACE_LEVEL_INFO, TRACE_LOOKUPS)                     \
+    /* value: strategies */                                                             \
+    X(TRACE_TOO_MANY_STRATEGIES, TRACE_LEVEL_ERROR, TRACE_LOOKUPS)                      \
+    /* offset of the token, arg: registry index, value: bytes of earnings used */       \
+    X(TRACE_TOKEN, TRACE_LEVEL_DEBUG, TRACE_LOOKUPS)                                    \
+    /* arg: registry index, value: bytes of earnings used */                            \
+    X(TRACE_NO_ROOM_FOR_EARNINGS, TRACE_LEVEL_INFO, TRACE_LOOKUPS)                      \
+    /* value: length */                                                                 \
+    X(TRACE_UNEXPECTED_SHARES_LENGTH, TRACE_LEVEL_ERROR, TRACE_LOOKUPS)                 \
+    X(TRACE_UNEXPECTED_SHARE, TRACE_LEVEL_ERROR, TRACE_LOOKUPS)                         \
+    /* arg: screen index */                                                             \
+    X(TRACE_INVALID_SCREEN, TRACE_LEVEL_ERROR, TRACE_UI)
+
+#define TO_TRACE_EVENT(name, level, category) name,
+typedef enum { TRACE_EVENTS(TO_TRACE_EVENT) TRACE_EVENT_COUNT } trace_event_t;
+
+// <event>_LEVEL and <event>_CATEGORY constants, so that TRACE is resolved at compile time
+#define TO_TRACE_LEVEL(name, level, category) name##_LEVEL = level, name##_CATEGORY = category,
+enum { TRACE_EVENTS(TO_TRACE_LEVEL) };
+
+_Static_assert(TRACE_EVENT_COUNT <= UINT8_MAX, "trace events do not fit in a record");
+
+// Binary record of an event, formatted only when the buffer is dumped.
+typedef struct {
+    uint8_t event;    // trace_event_t
+    uint8_t arg;      // small argument, see TRACE_EVENTS
+    uint16_t offset;  // calldata offset of the parameter, 0 if none
+    uint32_t value;   // argument, see TRACE_EVENTS
+} trace_record_t;
+
+void trace_record(trace_event_t event, uint16_t offset, uint8_t arg, uint32_t value);
+void trace_dump(void);
+
+/**
+ * Record an event in the ring buffer, errors also dump the buffer with PRINTF. Events above
+ * TRACE_LEVEL or out of TRACE_CATEGORIES are removed at compile time and their arguments are not
+ * evaluated.
+ *
+ * The plugin is relaunched by the Ethereum app for each callback, so on the device the buffer
+ * only holds the records of the current callback. The host tools keep it for the whole
+ * transaction.
+ */
+#define TRACE(event, offset, arg, value)                                                          \
+    do {                                                                                          \
+        if (event##_LEVEL <= TRACE_LEVEL && (event##_CATEGORY & (TRACE_CATEGORIES)) != 0) {       \
+            trace_record(event, (uint16_t) (offset), (uint8_t) (arg), (uint32_t) (value));        \
+        }                                                                                         \
+    } while (0)
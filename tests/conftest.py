@@ -1,6 +1,10 @@
+import os
 import pytest
 
-from ragger.conftest import configuration
+from pathlib import Path
+
+from ragger.conftest import base_conftest, configuration
+from .latency import LatencyReport
 from .utils import WalletAddr
 
 
@@ -13,7 +17,9 @@ from .utils import WalletAddr
 
 configuration.OPTIONAL.MAIN_APP_DIR = "tests/.test_dependencies/"
 
-configuration.OPTIONAL.BACKEND_SCOPE = "class"
+# One emulator per device for the whole session, see the tests README to run the devices in
+# parallel
+configuration.OPTIONAL.BACKEND_SCOPE = "session"
 
 
 #########################
@@ -23,6 +29,70 @@ configuration.OPTIONAL.BACKEND_SCOPE = "class"
 # Pull all features from the base ragger conftest using the overridden configuration
 pytest_plugins = ("ragger.conftest.base_conftest", )
 
+LATENCY_REPORT = pytest.StashKey[LatencyReport]()
+
+# Ports of the first Speculos instance, each pytest-xdist worker gets its own
+SPECULOS_API_PORT = 5000
+SPECULOS_APDU_PORT = 9999
+SPECULOS_PORTS_STRIDE = 10
+
+@pytest.fixture(scope=configuration.OPTIONAL.BACKEND_SCOPE)
+def backend(skip_tests_for_unsupported_devices, root_pytest_dir, backend_name, firmware, display,
+            log_apdu_file, cli_user_seed, additional_speculos_arguments):
+    '''
+    Backend of the ragger conftest, whose Speculos instance listens on the ports of the
+    pytest-xdist worker (gw0, gw1, ...) so that the devices run side by side
+    '''
+    worker = os.environ.get("PYTEST_XDIST_WORKER")
+    if worker is None or backend_name.lower() != "speculos":
+        instance = base_conftest.create_backend(root_pytest_dir, backend_name, firmware, display,
+                                                log_apdu_file, cli_user_seed,
+                                                additional_speculos_arguments)
+    else:
+        from ragger.backend import SpeculosBackend
+
+        offset = int(worker.lstrip("gw")) * SPECULOS_PORTS_STRIDE
+        main_app_path, speculos_args = base_conftest.prepare_speculos_args(
+            root_pytest_dir, firmware, display, cli_user_seed, additional_speculos_arguments)
+        speculos_args["args"] = list(speculos_args["args"]) + [
+            "--api-port", str(SPECULOS_API_PORT + offset),
+            "--apdu-port", str(SPECULOS_APDU_PORT + offset)]
+        instance = SpeculosBackend(main_app_path, firmware=firmware,
+                                   port=SPECULOS_API_PORT + offset, log_apdu_file=log_apdu_file,
+                                   **speculos_args)
+    with instance as b:
+        yield b
+
+def pytest_addoption(parser):
+    parser.addoption("--latency_runs", type=int, default=0,
+                     help="Runs of each selector in the latency benchmark, skipped when 0")
+    parser.addoption("--latency_output", type=Path, default=Path("latency.json"),
+                     help="Percentiles written by the latency benchmark")
+
+def pytest_configure(config):
+    config.stash[LATENCY_REPORT] = LatencyReport()
+
+def pytest_collection_modifyitems(config, items):
+    # with `--dist loadgroup`, all the tests of a device run on the same worker and emulator
+    if not config.pluginmanager.hasplugin("xdist"):
+        return
+    for item in items:
+        firmware = getattr(item, "callspec", None) and item.callspec.params.get("firmware")
+        if firmware is not None:
+            item.add_marker(pytest.mark.xdist_group(name=firmware.device))
+
+def pytest_terminal_summary(terminalreporter, config):
+    report = config.stash[LATENCY_REPORT]
+    if report:
+        report.write(config.getoption("latency_output"))
+        terminalreporter.section("latency (ms)")
+        for line in report.lines():
+            terminalreporter.write_line(line)
+
 @pytest.fixture
 def wallet_addr(backend):
     return WalletAddr(backend)
+
+@pytest.fixture
+def latency_report(request):
+    return request.config.stash[LATENCY_REPORT]
@@ -0,0 +1,76 @@
+"""
+The plugin built for the host as a shared library (see fuzzing/host_plugin.h), loaded with ctypes
+to get the screens of a transaction without Speculos. Build it with
+`make -C fuzzing/build plugin_host` (see fuzzing/README.md), or set PLUGIN_HOST_LIBRARY to its path.
+"""
+
+import ctypes
+import os
+from dataclasses import dataclass
+from enum import IntEnum
+from pathlib import Path
+from typing import List, Tuple
+
+LIBRARY = Path(os.environ.get(
+    "PLUGIN_HOST_LIBRARY",
+    Path(__file__).resolve().parent.parent / "fuzzing" / "build" / "libplugin_host.so"))
+
+HOST_TITLE_LENGTH = 32
+HOST_MSG_LENGTH = 79
+HOST_MAX_SCREENS = 1 + 2 * 255
+
+MAINNET_CHAIN_ID = 1
+
+
+class Status(IntEnum):
+    """host_status_t, the callback that rejected the transaction"""
+    OK = 0
+    INVALID_CALLDATA = 1
+    INIT_CONTRACT = 2
+    PROVIDE_PARAMETER = 3
+    FINALIZE = 4
+    PROVIDE_TOKEN = 5
+    QUERY_CONTRACT_ID = 6
+    QUERY_CONTRACT_UI = 7
+
+
+class Screen(ctypes.Structure):
+    _fields_ = [("title", ctypes.c_char * HOST_TITLE_LENGTH),
+                ("msg", ctypes.c_char * HOST_MSG_LENGTH)]
+
+
+@dataclass
+class Result:
+    status: Status
+    # (title, msg) of each screen, the ID screen first
+    screens: List[Tuple[str, str]]
+    # offset of the rejected parameter, or index of the rejected screen
+    position: int
+
+
+class HostPlugin:
+    def __init__(self, path: Path = LIBRARY):
+        self.library = ctypes.CDLL(str(path))
+        self.library.host_plugin_run.argtypes = [ctypes.c_char_p,
+                                                 ctypes.c_size_t,
+                                                 ctypes.c_uint64,
+                                                 ctypes.POINTER(Screen),
+                                                 ctypes.POINTER(ctypes.c_size_t),
+                                                 ctypes.POINTER(ctypes.c_size_t)]
+        self.library.host_plugin_run.restype = ctypes.c_int
+
+    def run(self, data: str, chain_id: int = MAINNET_CHAIN_ID) -> Result:
+        calldata = bytes.fromhex(data.removeprefix("0x"))
+        screens = (Screen * HOST_MAX_SCREENS)()
+        count = ctypes.c_size_t()
+        position = ctypes.c_size_t()
+        status = self.library.host_plugin_run(calldata,
+                                              len(calldata),
+                                              chain_id,
+                                              screens,
+                                              ctypes.byref(count),
+                                              ctypes.byref(position))
+        return Result(Status(status),
+                      [(screen.title.decode(), screen.msg.decode())
+                       for screen in screens[:count.value]],
+                      position.value)
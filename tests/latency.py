@@ -0,0 +1,144 @@
+"""
+End-to-end latency of the signatures on Speculos, measured by tests/tests/test_latency.py.
+Every APDU exchanged through the backend during a run is timestamped, along with the marks set by
+the test (first screen shown, signature received), and the samples of the repeated runs are
+summarized as percentiles per device and selector.
+"""
+
+import json
+import time
+from collections import defaultdict
+from contextlib import contextmanager
+from pathlib import Path
+from typing import Dict, List, Tuple
+
+INS_SET_EXTERNAL_PLUGIN = 0x12
+INS_SIGN = 0x04
+
+PERCENTILES = (50, 90, 99)
+
+TIME_TO_FIRST_SCREEN = "time_to_first_screen"
+TIME_TO_SIGNATURE = "time_to_signature"
+
+
+class ApduTimer:
+    """Timestamps of one run, in seconds since its first APDU"""
+
+    def __init__(self):
+        self.start = None
+        # name, start and end of each APDU and mark, a mark ends when it starts
+        self.events: List[Tuple[str, float, float]] = []
+        self.chunks = 0
+
+    def now(self) -> float:
+        now = time.perf_counter()
+        if self.start is None:
+            self.start = now
+        return now - self.start
+
+    def mark(self, name: str):
+        now = self.now()
+        self.events.append((name, now, now))
+
+    def apdu_name(self, data: bytes) -> str:
+        ins = data[1] if len(data) > 1 else None
+        if ins == INS_SET_EXTERNAL_PLUGIN:
+            return "set_external_plugin"
+        if ins == INS_SIGN:
+            self.chunks += 1
+            return f"sign_chunk_{self.chunks}"
+        return f"apdu_{ins}"
+
+    @contextmanager
+    def attach(self, backend):
+        """
+        Timestamp the APDUs exchanged through the backend. The last chunk of a signature is sent
+        asynchronously while the transaction is reviewed, the reception of its response marks
+        the signature.
+        """
+        exchange_raw = backend.exchange_raw
+        exchange_async_raw = backend.exchange_async_raw
+
+        def timed_exchange_raw(data: bytes = b"", *args, **kwargs):
+            name = self.apdu_name(data)
+            start = self.now()
+            response = exchange_raw(data, *args, **kwargs)
+            self.events.append((name, start, self.now()))
+            return response
+
+        @contextmanager
+        def timed_exchange_async_raw(data: bytes = b""):
+            self.mark(self.apdu_name(data))
+            with exchange_async_raw(data):
+                yield
+            self.mark(TIME_TO_SIGNATURE)
+
+        backend.exchange_raw = timed_exchange_raw
+        backend.exchange_async_raw = timed_exchange_async_raw
+        try:
+            yield self
+        finally:
+            # back to the methods of the backend class
+            del backend.exchange_raw
+            del backend.exchange_async_raw
+
+    def metrics(self) -> Dict[str, float]:
+        """
+        Duration of the synchronous APDUs, and time of the marks since the first APDU (including
+        the sending of the last chunk of the signature)
+        """
+        return {name: (end - start if end > start else end) for name, start, end in self.events}
+
+
+def percentile(values: List[float], rank: float) -> float:
+    """Percentile of the values, linearly interpolated between the closest ranks"""
+    ordered = sorted(values)
+    position = (len(ordered) - 1) * rank / 100
+    low = int(position)
+    high = min(low + 1, len(ordered) - 1)
+    return ordered[low] + (ordered[high] - ordered[low]) * (position - low)
+
+
+class LatencyReport:
+    """Samples of the runs, per device, selector and metric"""
+
+    def __init__(self):
+        self.samples = defaultdict(lambda: defaultdict(lambda: defaultdict(list)))
+
+    def __bool__(self):
+        return bool(self.samples)
+
+    def add(self, device: str, selector: str, timer: ApduTimer):
+        for metric, value in timer.metrics().items():
+            self.samples[device][selector][metric].append(value)
+
+    def summary(self) -> dict:
+        """Percentiles and maximum of each metric, in milliseconds"""
+        summary: dict = {}
+        for device, selectors in self.samples.items():
+            for selector, metrics in selectors.items():
+                for metric, values in metrics.items():
+                    stats = {"runs": len(values)}
+                    stats.update({f"p{rank}": round(percentile(values, rank) * 1000, 2)
+                                  for rank in PERCENTILES})
+                    stats["max"] = round(max(values) * 1000, 2)
+                    summary.setdefault(device, {}).setdefault(selector, {})[metric] = stats
+        return summary
+
+    def write(self, path: Path):
+        path.write_text(json.dumps(self.summary(), indent=2) + "\n")
+
+    def lines(self) -> List[str]:
+        """Time to first screen and time to signature of every device and selector, as a table"""
+        ranks = "".join(f"{'p' + str(rank):>10}" for rank in PERCENTILES)
+        lines = [f"{'device':<8}{'selector':<28}{'metric':<22}{'runs':>6}{ranks}{'max':>10}"]
+        for device, selectors in self.summary().items():
+            for selector, metrics in selectors.items():
+                for metric in (TIME_TO_FIRST_SCREEN, TIME_TO_SIGNATURE):
+                    if metric not in metrics:
+                        continue
+                    stats = metrics[metric]
+                    values = "".join(f"{stats[f'p{rank}']:>10.1f}" for rank in PERCENTILES)
+                    lines.append(f"{device:<8}{selector:<28}{metric:<22}{stats['runs']:>6}"
+                                 f"{values}{stats['max']:>10.1f}")
+        return lines
@@ -0,0 +1,300 @@
+"""
+Screens of the transactions of the Speculos tests, computed on the host through the shared library
+of tests/host.py and compared with the text snapshots of tests/text_snapshots. They check the
+parsing in milliseconds, the Speculos tests then only cover the rendering.
+Run with `--golden_run` to update the snapshots.
+"""
+
+from pathlib import Path
+from typing import List, Optional, Tuple
+
+import pytest
+
+from tests.host import LIBRARY, HostPlugin, Status
+from tests.transactions import (COMPLETE_QUEUED_WITHDRAWALS,
+                                COMPLETE_QUEUED_WITHDRAWALS_SLASHING, DELEGATE_TO,
+                                DEPOSIT_INTO_STRATEGY, PROCESS_CLAIM, QUEUE_WITHDRAWALS, UNDELEGATE)
+
+TEXT_SNAPSHOTS = Path(__file__).resolve().parent.parent / "text_snapshots"
+
+HOLESKY_CHAIN_ID = 17000
+
+# snapshot name (the Speculos test of the transaction), calldata, chain id
+TRANSACTIONS = [
+    ("test_undelegate", UNDELEGATE, 1),
+    ("test_delegate", DELEGATE_TO, 1),
+    ("test_queue_withdrawls", QUEUE_WITHDRAWALS, 1),
+    ("test_complete_queued_withdrawls", COMPLETE_QUEUED_WITHDRAWALS, 1),
+    ("test_deposit_into_strategy", DEPOSIT_INTO_STRATEGY, 1),
+    # mainnet strategies are unknown on other chains
+    ("test_queue_withdrawls_holesky", QUEUE_WITHDRAWALS, HOLESKY_CHAIN_ID),
+    # the withdrawer is the staker since the slashing release
+    ("test_complete_queued_withdrawls_slashing", COMPLETE_QUEUED_WITHDRAWALS_SLASHING, 1),
+    ("test_process_claim", PROCESS_CLAIM, 1),
+]
+
+
+@pytest.fixture(scope="module")
+def host_plugin():
+    if not LIBRARY.exists():
+        pytest.skip(f"{LIBRARY} not found, build it with `make -C fuzzing/build plugin_host`")
+    return HostPlugin()
+
+
+@pytest.mark.parametrize("name, data, chain_id", TRANSACTIONS, ids=[t[0] for t in TRANSACTIONS])
+def test_host_screens(request, host_plugin, name, data, chain_id):
+    result = host_plugin.run(data, chain_id)
+    assert result.status == Status.OK, f"rejected by {result.status.name} at {result.position}"
+
+    text = "".join(f"{title}: {msg}\n" for title, msg in result.screens)
+    snapshot = TEXT_SNAPSHOTS / f"{name}.txt"
+    if request.config.getoption("golden_run", default=False):
+        snapshot.parent.mkdir(exist_ok=True)
+        snapshot.write_text(text)
+    assert text == snapshot.read_text()
+
+
+def test_host_truncated_calldata(host_plugin):
+    # the last parameter is missing, the last array no longer fits in the calldata
+    result = host_plugin.run(COMPLETE_QUEUED_WITHDRAWALS[:-64])
+    assert result.status == Status.PROVIDE_PARAMETER
+
+
+def test_host_unknown_selector(host_plugin):
+    result = host_plugin.run("0x12345678")
+    assert result.status == Status.INIT_CONTRACT
+
+
+def test_host_invalid_offset(host_plugin):
+    # the offset of the withdrawals array is not where the array starts, which the parser only
+    # knows once every parameter is parsed
+    data = QUEUE_WITHDRAWALS[:2 + 8] + f"{0x40:064x}" + QUEUE_WITHDRAWALS[2 + 8 + 64:]
+    result = host_plugin.run(data)
+    assert result.status == Status.FINALIZE
+
+
+STETH = "ae7ab96520de3a18e5e111b5eaab095312d7fe84"
+CBETH = "be9895146f7af43049ca1c1ae358b0541ea49704"
+RETH = "ae78736cd615f374d3085123a210448e74fc6393"
+EIGEN = "ec53bf9167f50cdeb3ae105f56099aaab9061f83"
+
+
+def test_host_claim_duplicate_token(host_plugin):
+    # the cumulative earnings of the leaves of a token do not add up, each one is displayed
+    result = host_plugin.run(PROCESS_CLAIM.replace(CBETH, STETH))
+    assert result.status == Status.OK
+    assert result.screens[2:] == [("Cumulative earnings", "stETH 1.5"),
+                                  ("Cumulative earnings", "stETH 0.25"),
+                                  ("Token", "UNKNOWN")]
+
+
+def test_host_claim_many_tokens(host_plugin):
+    result = host_plugin.run(PROCESS_CLAIM.replace(EIGEN, RETH))
+    assert result.status == Status.OK
+    assert result.screens[2:] == [("Cumulative earnings", "stETH 1.5"),
+                                  ("Cumulative earnings", "rETH 12.3456789"),
+                                  ("Cumulative earnings", "cbETH 0.25")]
+
+
+def claim_leaves(leaves: List[Tuple[str, int]]) -> str:
+    # the token leaves are the last dynamic field of the claim, they can be replaced in place
+    tail = PROCESS_CLAIM.index(f"{3:064x}{STETH:0>64}")
+    return PROCESS_CLAIM[:tail] + f"{len(leaves):064x}" + "".join(
+        f"{token:0>64}{earnings:064x}" for token, earnings in leaves)
+
+
+def test_host_claim_earnings_full(host_plugin):
+    # two earnings of 26 bytes fill the context, the next leaves are flagged then counted
+    result = host_plugin.run(claim_leaves([(STETH, 2**200)] * 8))
+    assert result.status == Status.OK
+    assert [title for title, _ in result.screens[2:4]] == ["Cumulative earnings"] * 2
+    assert result.screens[4:] == [("Earnings not shown", "stETH")] * 4 + [("Leaves not shown", "2")]
+
+
+CBETH_STRATEGY = "54945180db7943c0ed0fee7edab2bd24620256bc"
+STETH_STRATEGY = "93c4b944d05dfe6df7645a86cd2206016c51564d"
+RETH_STRATEGY = "1bee69b7dfffa4e2d53c2a2df135c388ad25dcd2"
+ETHX_STRATEGY = "9d7ed45ee2e8fc5482fa2428f15c971e6369011d"
+WITHDRAWER = "b029e21e8d8a90c3fa58987a6bbf2b0563e5f6ab"
+
+
+def word(value: int) -> str:
+    return f"{value:064x}"
+
+
+def encode(fields: List[Tuple[bool, str]]) -> str:
+    # ABI encoding of a tuple from the (dynamic, encoding) of its fields
+    heads, tails = "", ""
+    offset = 32 * len(fields)
+    for dynamic, encoding in fields:
+        if dynamic:
+            heads += word(offset)
+            tails += encoding
+            offset += len(encoding) // 2
+        else:
+            heads += encoding
+    return heads + tails
+
+
+def array(elements: List[str], dynamic: bool = False) -> str:
+    return word(len(elements)) + encode([(dynamic, element) for element in elements])
+
+
+def queue_withdrawals(withdrawals: List[List[Tuple[str, int]]]) -> str:
+    params = [encode([(True, array([word(int(strategy, 16)) for strategy, _ in withdrawal])),
+                      (True, array([word(shares) for _, shares in withdrawal])),
+                      (False, word(int(WITHDRAWER, 16)))])
+              for withdrawal in withdrawals]
+    return "0x0dd8dd02" + encode([(True, array(params, dynamic=True))])
+
+
+def complete_queued_withdrawals(withdrawals: List[List[str]],
+                                tokens: List[List[str]],
+                                slashing: bool = False,
+                                withdrawer: str = WITHDRAWER,
+                                receive_as_tokens: Optional[List[bool]] = None) -> str:
+    # the staker and the operator it delegated to are WITHDRAWER
+    encoded = [encode([(False, word(int(WITHDRAWER, 16)))] * 2 +
+                      [(False, word(int(withdrawer, 16)))] +
+                      [(False, word(nonce)), (False, word(19000000 + nonce)),
+                       (True, array([word(int(strategy, 16)) for strategy in strategies])),
+                       (True, array([word(10**18)] * len(strategies)))])
+               for nonce, strategies in enumerate(withdrawals)]
+    if receive_as_tokens is None:
+        receive_as_tokens = [bool(withdrawal_tokens) for withdrawal_tokens in tokens]
+    fields = [(True, array(encoded, dynamic=True)),
+              (True, array([array([word(int(token, 16)) for token in withdrawal_tokens])
+                            for withdrawal_tokens in tokens], dynamic=True)),
+              (True, array([word(0)] * len(withdrawals))),
+              (True, array([word(int(flag)) for flag in receive_as_tokens]))]
+    if slashing:
+        # middlewareTimesIndexes was removed by the slashing release
+        return "0x9435bb43" + encode(fields[:2] + fields[3:])
+    return "0x33404396" + encode(fields)
+
+
+def test_host_receive_as_tokens_mix(host_plugin):
+    # the strategies of a withdrawal with an empty tokens array can not be left out of the pairing
+    result = host_plugin.run(complete_queued_withdrawals([[CBETH_STRATEGY], [STETH_STRATEGY]],
+                                                         [[], [STETH]]))
+    assert result.status == Status.FINALIZE
+
+    # a swap within a withdrawal received as tokens is not hidden by a withdrawal received as shares
+    result = host_plugin.run(complete_queued_withdrawals(
+        [[CBETH_STRATEGY], [STETH_STRATEGY, RETH_STRATEGY]], [[], [RETH, STETH]]))
+    assert result.status == Status.FINALIZE
+
+    # the tokens arrays of the withdrawals received as shares may be filled, they are paired
+    result = host_plugin.run(complete_queued_withdrawals([[CBETH_STRATEGY], [STETH_STRATEGY]],
+                                                         [[CBETH], [STETH]],
+                                                         receive_as_tokens=[False, True]))
+    assert result.status == Status.OK
+    assert result.screens[2:] == [("Total shares", "cbETH 1"), ("Total shares", "stETH 1")]
+
+    result = host_plugin.run(complete_queued_withdrawals([[CBETH_STRATEGY], [STETH_STRATEGY]],
+                                                         [[STETH], [CBETH]],
+                                                         receive_as_tokens=[False, True]))
+    assert result.status == Status.FINALIZE
+
+
+def test_host_receive_as_shares(host_plugin):
+    # nothing is received as tokens
+    result = host_plugin.run(complete_queued_withdrawals([[CBETH_STRATEGY], [STETH_STRATEGY]],
+                                                         [[], []]))
+    assert result.status == Status.OK
+    assert result.screens[2:] == [("Total shares", "cbETH 1"), ("Total shares", "stETH 1")]
+
+
+def test_host_unknown_strategy_known_token(host_plugin):
+    # an unknown strategy only pairs with an unknown token
+    result = host_plugin.run(COMPLETE_QUEUED_WITHDRAWALS.replace(ETHX_STRATEGY, "11" * 20))
+    assert result.status == Status.FINALIZE
+
+    result = host_plugin.run(complete_queued_withdrawals([["11" * 20, STETH_STRATEGY]],
+                                                         [["22" * 20, STETH]]))
+    assert result.status == Status.OK
+    assert result.screens[2:] == [("Strategy", "UNKNOWN"), ("Total shares", "stETH 1")]
+
+
+def test_host_tokens_mismatch(host_plugin):
+    # each tokens array is paired with the strategies of its withdrawal
+    result = host_plugin.run(complete_queued_withdrawals(
+        [[CBETH_STRATEGY], [STETH_STRATEGY, RETH_STRATEGY]], [[CBETH, STETH], [RETH]]))
+    assert result.status == Status.FINALIZE
+
+    result = host_plugin.run(complete_queued_withdrawals(
+        [[CBETH_STRATEGY], [STETH_STRATEGY, RETH_STRATEGY]], [[CBETH], [STETH, RETH]]))
+    assert result.status == Status.OK
+
+
+def test_host_scaled_shares(host_plugin):
+    result = host_plugin.run(complete_queued_withdrawals([[CBETH_STRATEGY]] * 2, [[CBETH]] * 2,
+                                                         slashing=True))
+    assert result.status == Status.OK
+    assert result.screens[2:] == [("Scaled shares", "cbETH 2")]
+
+
+def test_host_scaled_shares_withdrawer(host_plugin):
+    # a withdrawal queued before the slashing release may have a withdrawer other than the staker
+    other = "d8da6bf26964af9d7eed9e03e53415d37aa96045"
+    result = host_plugin.run(complete_queued_withdrawals([[CBETH_STRATEGY]], [[CBETH]],
+                                                         slashing=True, withdrawer=other))
+    assert result.status == Status.OK
+    assert result.screens[1][0] == "Withdrawer"
+    assert result.screens[1][1].lower() == "0x" + other
+
+
+def test_host_alternating_strategies(host_plugin):
+    # the list only holds the current withdrawal, the distinct strategies display the batch
+    withdrawal = [(CBETH_STRATEGY, 10**18), (STETH_STRATEGY, 2 * 10**18),
+                  (RETH_STRATEGY, 3 * 10**18), (ETHX_STRATEGY, 4 * 10**18)]
+    result = host_plugin.run(queue_withdrawals([withdrawal] * 30))
+    assert result.status == Status.OK
+    assert result.screens[2:] == [("Total shares", "cbETH 30"), ("Total shares", "stETH 60"),
+                                  ("Total shares", "rETH 90"), ("Total shares", "ETHx 120")]
+
+
+def test_host_large_shares(host_plugin):
+    # totals are exact on 256 bits
+    withdrawal = [(CBETH_STRATEGY, 2**200), (STETH_STRATEGY, 10**18)]
+    result = host_plugin.run(queue_withdrawals([withdrawal] * 2))
+    assert result.status == Status.OK
+    assert result.screens[2:] == [("Total shares", f"cbETH {2**201 // 10**18}.{2**201 % 10**18}"),
+                                  ("Total shares", "stETH 2")]
+
+
+def test_host_shares_total_overflow(host_plugin):
+    # a strategy whose total overflows 256 bits is flagged, without total
+    withdrawal = [(CBETH_STRATEGY, 2**255), (STETH_STRATEGY, 10**18)]
+    result = host_plugin.run(queue_withdrawals([withdrawal] * 2))
+    assert result.status == Status.OK
+    assert result.screens[2:] == [("Shares not shown", "cbETH"), ("Total shares", "stETH 2")]
+
+
+def test_host_shares_totals_full(host_plugin):
+    # so is a strategy whose total does not fit in the context
+    withdrawal = [(CBETH_STRATEGY, 2**200), (STETH_STRATEGY, 2**200)]
+    result = host_plugin.run(queue_withdrawals([withdrawal]))
+    assert result.status == Status.OK
+    assert result.screens[2:] == [("Total shares", f"cbETH {2**200 // 10**18}.{2**200 % 10**18}"),
+                                  ("Shares not shown", "stETH")]
+
+
+MAINNET_STRATEGIES = {
+    "cbETH": CBETH_STRATEGY,
+    "stETH": STETH_STRATEGY,
+    "rETH": RETH_STRATEGY,
+    "ETHx": ETHX_STRATEGY,
+    "ankrETH": "13760f50a9d7377e4f20cb8cf9e4c26586c658ff",
+    "OETH": "a4c637e0f704745d182e4d38cab7e7485321d059",
+    "osETH": "57ba429517c3473b6d34ca9acd56c0e735b94c02",
+}
+
+
+def test_host_strategies_make_room(host_plugin):
+    # every distinct strategy is displayed, the totals make room for them
+    withdrawals = [[(strategy, 2**250 if ticker == "cbETH" else 1)]
+                   for ticker, strategy in MAINNET_STRATEGIES.items()]
+    result = host_plugin.run(queue_withdrawals(withdrawals))
+    assert result.status == Status.OK
+    assert result.screens[2:] == [("Shares not shown", ticker) for ticker in MAINNET_STRATEGIES]
@@ -0,0 +1,70 @@
+"""
+End-to-end latency of the signature of each selector on Speculos, through the same EthAppClient
+flow as the functional tests. Every APDU is timestamped (set external plugin, each sign chunk), as
+well as the first screen of the review and the reception of the signature, see tests/latency.py.
+Skipped unless `--latency_runs` is set, the percentiles over the runs are printed per device at the
+end of the session and written to `--latency_output`:
+
+    pytest tests/tests/test_latency.py --device all --latency_runs 20
+"""
+
+import pytest
+
+from ledger_app_clients.ethereum.client import EthAppClient
+from ledger_app_clients.ethereum.utils import get_selector_from_data, recover_transaction
+import ledger_app_clients.ethereum.response_parser as ResponseParser
+
+from tests.latency import TIME_TO_FIRST_SCREEN, ApduTimer
+from tests.transactions import (COMPLETE_QUEUED_WITHDRAWALS, DELEGATE_TO, DEPOSIT_INTO_STRATEGY,
+                                QUEUE_WITHDRAWALS, UNDELEGATE)
+from tests.utils import (DERIVATION_PATH, PLUGIN_NAME, build_tx_params, load_contract,
+                         review_instructions)
+
+contract_delegation_manager = load_contract(
+    "39053d51b77dc0d36036fc1fcc8cb819df8ef37a"
+)
+
+contract_strategy_manager = load_contract(
+    "858646372cc42e1a627fce94aa7a7033e7cf075a"
+)
+
+SELECTORS = [
+    ("undelegate", contract_delegation_manager, UNDELEGATE),
+    ("delegateTo", contract_delegation_manager, DELEGATE_TO),
+    ("queueWithdrawals", contract_delegation_manager, QUEUE_WITHDRAWALS),
+    ("completeQueuedWithdrawals", contract_delegation_manager, COMPLETE_QUEUED_WITHDRAWALS),
+    ("depositIntoStrategy", contract_strategy_manager, DEPOSIT_INTO_STRATEGY),
+]
+
+
+def sign(contract, data, backend, firmware, navigator, timer):
+    client = EthAppClient(backend)
+    tx_params = build_tx_params(contract, data)
+    instruction, validation, text = review_instructions(firmware)
+
+    with timer.attach(backend):
+        client.set_external_plugin(PLUGIN_NAME, contract.address, get_selector_from_data(data))
+        with client.sign(DERIVATION_PATH, tx_params):
+            backend.wait_for_screen_change()
+            timer.mark(TIME_TO_FIRST_SCREEN)
+            # no snapshot comparison, the review is already on its first screen
+            navigator.navigate_until_text(instruction,
+                                          validation,
+                                          text,
+                                          screen_change_before_first_instruction=False)
+    return tx_params, ResponseParser.signature(client.response().data)
+
+
+@pytest.mark.parametrize("name, contract, data", SELECTORS, ids=[s[0] for s in SELECTORS])
+def test_latency(request, backend, firmware, navigator, wallet_addr, latency_report,
+                 name, contract, data):
+    runs = request.config.getoption("latency_runs")
+    if runs <= 0:
+        pytest.skip("latency benchmark, set --latency_runs to run it")
+
+    expected = wallet_addr.get()
+    for _ in range(runs):
+        timer = ApduTimer()
+        tx_params, vrs = sign(contract, data, backend, firmware, navigator, timer)
+        assert recover_transaction(tx_params, vrs) == expected
+        latency_report.add(firmware.device, name, timer)
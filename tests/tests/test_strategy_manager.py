@@ -1,5 +1,6 @@
 from web3 import Web3
 from tests.utils import run_test, load_contract
+from tests.transactions import DEPOSIT_INTO_STRATEGY
 
 contract_strategy_manager = load_contract(
     "858646372cc42e1a627fce94aa7a7033e7cf075a"
@@ -7,7 +8,7 @@ contract_strategy_manager = load_contract(
 
 #https://etherscan.io/tx/0xef04d0d081eb61318f79ec49c77dd4699b723e92bedbe2c3766d6a39764a3557
 def test_deposit_into_strategy(backend, firmware, navigator, test_name, wallet_addr):
-    data = "0xe7a050aa00000000000000000000000093c4b944d05dfe6df7645a86cd2206016c51564d000000000000000000000000ae7ab96520de3a18e5e111b5eaab095312d7fe8400000000000000000000000000000000000000000000000000005af3107a4000"
+    data = DEPOSIT_INTO_STRATEGY
     run_test(
         contract_strategy_manager, 
         data, 
@@ -0,0 +1,26 @@
+"""
+Calldata of the transactions replayed by the tests, on Speculos by test_*_manager.py and on the
+host by test_host_parser.py.
+"""
+
+#https://etherscan.io/tx/0xdbc21a553e3036bede09bde344d0671a72bb298c51c0e2336b978ec2fe55a4b5
+UNDELEGATE = "0xda8be8640000000000000000000000006cca0299d7bf42afe88c0c3e39b97868601611d7"
+
+#https://etherscan.io/tx/0x6d46a9ed90e4fcd1615ab8ab03bfaa3d1ed5bba5b71c74184b0e96c42c35fde6
+DELEGATE_TO = "0xeea9064b0000000000000000000000004cd2086e1d708e65db5d4f5712a9ca46ed4bbd0a00000000000000000000000000000000000000000000000000000000000000600000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000004000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000"
+
+#https://etherscan.io/tx/0x16fca2452f124b776febf429f50a47ccc97049c6c8c1cc22221044f4d54ae601
+QUEUE_WITHDRAWALS = "0x0dd8dd020000000000000000000000000000000000000000000000000000000000000020000000000000000000000000000000000000000000000000000000000000000200000000000000000000000000000000000000000000000000000000000000400000000000000000000000000000000000000000000000000000000000000120000000000000000000000000000000000000000000000000000000000000006000000000000000000000000000000000000000000000000000000000000000a0000000000000000000000000b029e21e8d8a90c3fa58987a6bbf2b0563e5f6ab0000000000000000000000000000000000000000000000000000000000000001000000000000000000000000acb55c530acdb2849e6d4f36992cd8c9d50ed8f7000000000000000000000000000000000000000000000000000000000000000100000000000000000000000000000000000000000000000dfbc41f1cf64ab60c000000000000000000000000000000000000000000000000000000000000006000000000000000000000000000000000000000000000000000000000000000a0000000000000000000000000b029e21e8d8a90c3fa58987a6bbf2b0563e5f6ab000000000000000000000000000000000000000000000000000000000000000100000000000000000000000054945180db7943c0ed0fee7edab2bd24620256bc0000000000000000000000000000000000000000000000000000000000000001000000000000000000000000000000000000000000000000072c27dcee1fd5db"
+
+#https://etherscan.io/tx/0xc18712afbe8a995c7ce15014435857554b983674bc46aa489d4905e56a82e9b9
+COMPLETE_QUEUED_WITHDRAWALS = "0x334043960000000000000000000000000000000000000000000000000000000000000080000000000000000000000000000000000000000000000000000000000000022000000000000000000000000000000000000000000000000000000000000002a000000000000000000000000000000000000000000000000000000000000002e000000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000000000000000000000000000000000000020000000000000000000000000152f804c2257aa26b353da4123cd9befc47882440000000000000000000000000000000000000000000000000000000000000000000000000000000000000000152f804c2257aa26b353da4123cd9befc4788244000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000012e470000000000000000000000000000000000000000000000000000000000000000e0000000000000000000000000000000000000000000000000000000000000012000000000000000000000000000000000000000000000000000000000000000010000000000000000000000009d7ed45ee2e8fc5482fa2428f15c971e6369011d000000000000000000000000000000000000000000000000000000000000000100000000000000000000000000000000000000000000000010858c754ea44fe3000000000000000000000000000000000000000000000000000000000000000100000000000000000000000000000000000000000000000000000000000000200000000000000000000000000000000000000000000000000000000000000001000000000000000000000000a35b1b31ce002fbf2058d22f30f95d405200a15b0000000000000000000000000000000000000000000000000000000000000001000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000000000000000000000000000000000000001"
+
+# the withdrawals of COMPLETE_QUEUED_WITHDRAWALS completed after the slashing release, whose
+# completeQueuedWithdrawals no longer takes middlewareTimesIndexes
+COMPLETE_QUEUED_WITHDRAWALS_SLASHING = "0x9435bb4300000000000000000000000000000000000000000000000000000000000000600000000000000000000000000000000000000000000000000000000000000200000000000000000000000000000000000000000000000000000000000000028000000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000000000000000000000000000000000000020000000000000000000000000152f804c2257aa26b353da4123cd9befc47882440000000000000000000000000000000000000000000000000000000000000000000000000000000000000000152f804c2257aa26b353da4123cd9befc4788244000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000012e470000000000000000000000000000000000000000000000000000000000000000e0000000000000000000000000000000000000000000000000000000000000012000000000000000000000000000000000000000000000000000000000000000010000000000000000000000009d7ed45ee2e8fc5482fa2428f15c971e6369011d000000000000000000000000000000000000000000000000000000000000000100000000000000000000000000000000000000000000000010858c754ea44fe3000000000000000000000000000000000000000000000000000000000000000100000000000000000000000000000000000000000000000000000000000000200000000000000000000000000000000000000000000000000000000000000001000000000000000000000000a35b1b31ce002fbf2058d22f30f95d405200a15b00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000000000000000000000000000000000000001"
+
+#https://etherscan.io/tx/0xef04d0d081eb61318f79ec49c77dd4699b723e92bedbe2c3766d6a39764a3557
+DEPOSIT_INTO_STRATEGY = "0xe7a050aa00000000000000000000000093c4b944d05dfe6df7645a86cd2206016c51564d000000000000000000000000ae7ab96520de3a18e5e111b5eaab095312d7fe8400000000000000000000000000000000000000000000000000005af3107a4000"
+
+# a claim of three token leaves (stETH, EIGEN and cbETH) with their Merkle proofs
+PROCESS_CLAIM = "0x3ccc861d0000000000000000000000000000000000000000000000000000000000000040000000000000000000000000152f804c2257aa26b353da4123cd9befc4788244000000000000000000000000000000000000000000000000000000000000005e00000000000000000000000000000000000000000000000000000000000004d20000000000000000000000000000000000000000000000000000000000000100000000000000000000000000152f804c2257aa26b353da4123cd9befc47882444813494d137e1631bba301d5acab6e7bb7aa74ce1185d456565ef51d737677b200000000000000000000000000000000000000000000000000000000000003000000000000000000000000000000000000000000000000000000000000000380000000000000000000000000000000000000000000000000000000000000058000000000000000000000000000000000000000000000000000000000000001e08be454eb482e90589aa66e928ce10e7096fcb087ee1e84be197a2613476b897a54dd7b880d11a3975bb17abab42e5bb42d701946992afe4f482fb92a9e6505e4dc734014c5dce67bff107db0ad09ebc7b818702fe589ff96f663566d3a26a21177aeed17eb7a01561c6f6e5ed896a34821642709a711d644b47495aa385de78f3ef9b8d9c9ba28e59181867d421014e9d3147a04f4df1aaa43257864ea5838f99ec0e0d1dc07dbbb96d90dff1415f05929c8375d01e699a284a2b41772097f4a9d19a99aa5ceeb0c46b559f0d6d000df7d76dcb3e686ce0ff274acc6cd9cdb0394fe4bd3ffd15b90c8d47a3920cbe159076f37d3e9d474fcb7f5835daf043a40926b1e2915d17749a8283a78c1dbe6a9b68ef115851d7b434c67ddf5ad86d5d59bad3c542d5c1626d3f8f8cd712c35c2615946264a0d4ef977fb0bd404a72ff94b04a6d30b555d0d9458d57be6c9306edea668e304dbb780fcb991272521d5b14eeaa1ad9ed58f0533cb1f2c3efd02f944ebe5bf1bb103ee9a084918f90e4a209be76173a8dc69d98ed6991f22fe37641172253614152a1e679ead4b1f097786997483b54249df930b4a31ef01b324aac735e560d5372e4d166b4ef82b797a98047dc6ddad99138e2fb35da27bc9b519ffdf17e9962d004227f6a0aaf620051000000000000000000000000000000000000000000000000000000000000000030000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000100000000000000000000000000000000000000000000000000000000000000020000000000000000000000000000000000000000000000000000000000000003000000000000000000000000000000000000000000000000000000000000006000000000000000000000000000000000000000000000000000000000000000e000000000000000000000000000000000000000000000000000000000000001600000000000000000000000000000000000000000000000000000000000000060677578fa480df7daa517233a6a8ac2ec5a5b88eec9a32e1764574bf97c140ffdd3a0979439020fcc462a4c4f39971e29a8d2d549a089cd7489f14843d8759b3a3bddfd245b27109b917a54f2b2c6f252916202f0a49ecd2ed274bbbf43de46910000000000000000000000000000000000000000000000000000000000000060df3e6b0bb66ceaadca4f84cbc371fd66e04d20fe51fc414da8d1b84d31d178de234d8f26b62f633ac276fe8b01a1b9d6f3dfd12c3e4774554a2d3f401ee170cb13913120ea404a6622da0cad8e1d725a06699c2f78d9777b3ca94acd01eb3b790000000000000000000000000000000000000000000000000000000000000060d8cc7aed3851ac3338fcc15df3b6807b89125837f77a75b9ecb13ed2afe3b49f41482659c13bbed7d3e9695016b0ee16fd2e8a9c05c68b143e68be45c8a4bebfcd0c96794c14ef72bc8881110e1132d5f34cb85bdaa5039ddd8e4654875669410000000000000000000000000000000000000000000000000000000000000003000000000000000000000000ae7ab96520de3a18e5e111b5eaab095312d7fe8400000000000000000000000000000000000000000000000014d1120d7b160000000000000000000000000000ec53bf9167f50cdeb3ae105f56099aaab9061f83000000000000000000000000000000000000000000000000ab54a98ca1890800000000000000000000000000be9895146f7af43049ca1c1ae358b0541ea4970400000000000000000000000000000000000000000000000003782dace9d90000"
@@ -2,6 +2,8 @@ import os
 import re
 import json
 
+from contextlib import contextmanager
+
 from web3 import Web3
 from eth_typing import ChainId
 
@@ -54,16 +56,8 @@ def load_contract(address):
             )
         )
 
-def run_test(contract, data, backend, firmware, navigator, test_name, wallet_addr, value=0, gas=300000):
-    client = EthAppClient(backend)
-
-    # first setup the external plugin
-    client.set_external_plugin(PLUGIN_NAME,
-                               contract.address,
-                               # Extract function selector from the encoded data
-                               get_selector_from_data(data))
-
-    tx_params = {
+def build_tx_params(contract, data, value=0, gas=300000):
+    return {
         "nonce": 20,
         "maxFeePerGas": Web3.to_wei(145, "gwei"),
         "maxPriorityFeePerGas": Web3.to_wei(1.5, "gwei"),
@@ -74,22 +68,77 @@ def run_test(contract, data, backend, firmware, navigator, test_name, wallet_add
         "data": data
     }
 
+def review_instructions(firmware):
+    '''
+    Navigation that reviews and accepts a transaction on this device: the instruction moving to
+    the next screen, the instructions accepting it, and the text of the accepting screen
+    '''
+    if firmware.is_nano:
+        return NavInsID.RIGHT_CLICK, [NavInsID.BOTH_CLICK], "Accept"
+    return (NavInsID.USE_CASE_REVIEW_TAP,
+            [NavInsID.USE_CASE_REVIEW_CONFIRM, NavInsID.USE_CASE_STATUS_DISMISS],
+            "Hold to sign")
+
+@contextmanager
+def sent_apdus(backend):
+    '''
+    Record the APDUs sent synchronously through the backend
+    '''
+    apdus = []
+    exchange_raw = backend.exchange_raw
+
+    def recording_exchange_raw(data: bytes = b"", *args, **kwargs):
+        apdus.append(bytes(data))
+        return exchange_raw(data, *args, **kwargs)
+
+    backend.exchange_raw = recording_exchange_raw
+    try:
+        yield apdus
+    finally:
+        # back to the method of the backend class
+        del backend.exchange_raw
+
+class PluginProvisioning:
+    '''
+    The Ethereum app forgets the external plugin after each transaction. Its provisioning APDU is
+    built and signed with the test key once per (contract, selector) pair, then replayed as is.
+    '''
+    def __init__(self):
+        self.apdus = {}
+
+    def provide(self, backend, contract, selector):
+        key = (contract.address, selector)
+        if key in self.apdus:
+            response = backend.exchange_raw(self.apdus[key])
+            assert response.status == 0x9000
+            return
+        with sent_apdus(backend) as apdus:
+            EthAppClient(backend).set_external_plugin(PLUGIN_NAME, contract.address, selector)
+        self.apdus[key] = apdus[-1]
+
+# shared by all the tests of the session
+PROVISIONING = PluginProvisioning()
+
+def run_test(contract, data, backend, firmware, navigator, test_name, wallet_addr, value=0, gas=300000):
+    client = EthAppClient(backend)
+
+    # first setup the external plugin
+    PROVISIONING.provide(backend,
+                         contract,
+                         # Extract function selector from the encoded data
+                         get_selector_from_data(data))
+
+    tx_params = build_tx_params(contract, data, value, gas)
+
     # send the transaction
     with client.sign(DERIVATION_PATH, tx_params):
         # Validate the on-screen request by performing the navigation appropriate for this device
-        if firmware.is_nano:
-            navigator.navigate_until_text_and_compare(NavInsID.RIGHT_CLICK,
-                                                      [NavInsID.BOTH_CLICK],
-                                                      "Accept",
-                                                      ROOT_SCREENSHOT_PATH,
-                                                      test_name)
-        else:
-            navigator.navigate_until_text_and_compare(NavInsID.USE_CASE_REVIEW_TAP,
-                                                      [NavInsID.USE_CASE_REVIEW_CONFIRM,
-                                                       NavInsID.USE_CASE_STATUS_DISMISS],
-                                                      "Hold to sign",
-                                                      ROOT_SCREENSHOT_PATH,
-                                                      test_name)
+        instruction, validation, text = review_instructions(firmware)
+        navigator.navigate_until_text_and_compare(instruction,
+                                                  validation,
+                                                  text,
+                                                  ROOT_SCREENSHOT_PATH,
+                                                  test_name)
     # verify signature
     vrs = ResponseParser.signature(client.response().data)
     addr = recover_transaction(tx_params, vrs)
@@ -0,0 +1,325 @@
+#!/usr/bin/env python3
+"""
+Generate the calldata parser tables of the plugin from the ABIs in tests/abis.
+
+Each supported function is flattened into a tree of `abi_node_t` (see src/parser.h): tuples,
+dynamic arrays, bytes and single parameter words, along with the `parameter` captured by the
+plugin when a node is parsed. The table interpreter in src/parser.c walks this tree while the
+Ethereum application streams the calldata, so supporting a new function only takes an entry in
+FUNCTIONS below and the handling of its captured parameters.
+"""
+
+import json
+import re
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+ABIS = ROOT / "tests" / "abis"
+PLUGIN_H = ROOT / "src" / "plugin.h"
+OUTPUT_C = ROOT / "src" / "parser_tables.c"
+OUTPUT_H = ROOT / "src" / "parser_tables.h"
+
+DELEGATION_MANAGER = "0x39053d51b77dc0d36036fc1fcc8cb819df8ef37a"
+# DelegationManager implementation since the slashing release, behind the same proxy
+DELEGATION_MANAGER_SLASHING = f"{DELEGATION_MANAGER}.slashing"
+STRATEGY_MANAGER = "0x858646372cc42e1a627fce94aa7a7033e7cf075a"
+REWARDS_COORDINATOR = "0x7750d328b314effa365a0402ccfd489b80b0adda"
+
+
+def withdrawal_fields(path, shares):
+    """
+    Parameters captured in the strategies and shares of a withdrawal, the slashing release renamed
+    the shares (depositShares when queued, scaledShares when completed) without moving them
+    """
+    return {
+        f"{path}.strategies": "STRATEGIES_SIZE",
+        f"{path}.strategies[]": "STRATEGY",
+        f"{path}.{shares}": "SHARES_SIZE",
+        f"{path}.{shares}[]": "SHARE",
+    }
+
+
+# Functions parsed by the plugin: contract, function name, selector name in SELECTORS_LIST and
+# the parameters captured by the plugin, by path in the function inputs ("[]" stands for the
+# elements of an array, an array path alone for its length). Every other parameter is skipped.
+# A selector listed for several ABIs must get the same tables from each of them.
+FUNCTIONS = [
+    (STRATEGY_MANAGER, "depositIntoStrategy", "DEPOSIT_INTO_STRATEGY", {
+        "strategy": "STRATEGY",
+        "token": "TOKEN",
+        "amount": "AMOUNT",
+    }),
+    (DELEGATION_MANAGER, "delegateTo", "DELEGATE_TO", {
+        "operator": "OPERATOR",
+    }),
+    (DELEGATION_MANAGER, "undelegate", "UNDELEGATE", {
+        "staker": "STAKER",
+    }),
+    (DELEGATION_MANAGER, "queueWithdrawals", "QUEUE_WITHDRAWAL_PARAMS", {
+        **withdrawal_fields("queuedWithdrawalParams[]", "shares"),
+        "queuedWithdrawalParams[].withdrawer": "WITHDRAWER",
+    }),
+    # same signature, the withdrawer is deprecated and must be the sender
+    (DELEGATION_MANAGER_SLASHING, "queueWithdrawals", "QUEUE_WITHDRAWAL_PARAMS", {
+        **withdrawal_fields("params[]", "depositShares"),
+        "params[].__deprecated_withdrawer": "WITHDRAWER",
+    }),
+    (DELEGATION_MANAGER, "completeQueuedWithdrawals", "COMPLETE_QUEUED_WITHDRAWALS", {
+        "withdrawals[].withdrawer": "WITHDRAWER",
+        **withdrawal_fields("withdrawals[]", "shares"),
+        "tokens": "TOKENS_SIZE",
+        "tokens[]": "WITHDRAWAL_TOKENS_SIZE",
+        "tokens[][]": "TOKEN",
+        "middlewareTimesIndexes": "MIDDLEWARE_TIMES_SIZE",
+        "receiveAsTokens": "RECEIVE_AS_TOKENS_SIZE",
+    }),
+    # new selector, middlewareTimesIndexes was removed
+    (DELEGATION_MANAGER_SLASHING, "completeQueuedWithdrawals",
+     "COMPLETE_QUEUED_WITHDRAWALS_SLASHING", {
+         "withdrawals[].withdrawer": "WITHDRAWER",
+         **withdrawal_fields("withdrawals[]", "scaledShares"),
+         "tokens": "TOKENS_SIZE",
+         "tokens[]": "WITHDRAWAL_TOKENS_SIZE",
+         "tokens[][]": "TOKEN",
+         "receiveAsTokens": "RECEIVE_AS_TOKENS_SIZE",
+     }),
+    # the proofs are skipped, the earnings are summed per token
+    (REWARDS_COORDINATOR, "processClaim", "PROCESS_CLAIM", {
+        "claim.tokenLeaves[].token": "TOKEN",
+        "claim.tokenLeaves[].cumulativeEarnings": "EARNINGS",
+        "recipient": "RECIPIENT",
+    }),
+]
+
+NO_NODE = 0xFF
+
+
+def keccak256(data: bytes) -> bytes:
+    """Keccak-256 as used by Ethereum, hashlib only provides the final SHA3 standard"""
+    round_constants = [
+        0x0000000000000001, 0x0000000000008082, 0x800000000000808A, 0x8000000080008000,
+        0x000000000000808B, 0x0000000080000001, 0x8000000080008081, 0x8000000000008009,
+        0x000000000000008A, 0x0000000000000088, 0x0000000080008009, 0x000000008000000A,
+        0x000000008000808B, 0x800000000000008B, 0x8000000000008089, 0x8000000000008003,
+        0x8000000000008002, 0x8000000000000080, 0x000000000000800A, 0x800000008000000A,
+        0x8000000080008081, 0x8000000000008080, 0x0000000080000001, 0x8000000080008008,
+    ]
+    rotations = [[0, 36, 3, 41, 18], [1, 44, 10, 45, 2], [62, 6, 43, 15, 61],
+                 [28, 55, 25, 21, 56], [27, 20, 39, 8, 14]]
+    mask = (1 << 64) - 1
+
+    def rol(value, shift):
+        return ((value << shift) | (value >> (64 - shift))) & mask if shift else value
+
+    rate = 136
+    padded = bytearray(data) + b"\x01" + bytes((-len(data) - 1) % rate)
+    padded[-1] |= 0x80
+    state = [[0] * 5 for _ in range(5)]
+    for block in range(0, len(padded), rate):
+        for i in range(rate // 8):
+            lane = padded[block + 8 * i:block + 8 * i + 8]
+            state[i % 5][i // 5] ^= int.from_bytes(lane, "little")
+        for round_constant in round_constants:
+            c = [state[x][0] ^ state[x][1] ^ state[x][2] ^ state[x][3] ^ state[x][4]
+                 for x in range(5)]
+            d = [c[(x - 1) % 5] ^ rol(c[(x + 1) % 5], 1) for x in range(5)]
+            state = [[state[x][y] ^ d[x] for y in range(5)] for x in range(5)]
+            b = [[0] * 5 for _ in range(5)]
+            for x in range(5):
+                for y in range(5):
+                    b[y][(2 * x + 3 * y) % 5] = rol(state[x][y], rotations[x][y])
+            state = [[b[x][y] ^ (~b[(x + 1) % 5][y] & b[(x + 2) % 5][y]) for y in range(5)]
+                     for x in range(5)]
+            state[0][0] ^= round_constant
+    return b"".join(state[i % 5][i // 5].to_bytes(8, "little") for i in range(4))
+
+
+def canonical_type(param) -> str:
+    """Type of an ABI parameter as written in a function signature"""
+    abi_type = param["type"]
+    if abi_type.startswith("tuple"):
+        fields = ",".join(canonical_type(field) for field in param["components"])
+        return f"({fields}){abi_type[len('tuple'):]}"
+    return abi_type
+
+
+class Node:
+    def __init__(self, kind, path, dynamic, size=1):
+        self.kind = kind
+        self.path = path
+        self.dynamic = dynamic
+        self.size = size  # number of head parameters when static
+        self.words = 1  # minimum number of parameters of the encoding, heads and tails
+        self.children = []
+        self.field = "NONE"
+        self.head = 0
+        self.index = None
+
+
+def build(param, path) -> Node:
+    """Build the node tree of an ABI parameter"""
+    abi_type = param["type"]
+    array = re.fullmatch(r"(.*)\[(\d*)\]", abi_type)
+    if array:
+        element = build(dict(param, type=array.group(1)), path + "[]")
+        if array.group(2) == "":
+            node = Node("ABI_ARRAY", path, True)
+            node.children = [element]
+            return node
+        # fixed size arrays are encoded like tuples
+        length = int(array.group(2))
+        elements = [build(dict(param, type=array.group(1)), path + "[]") for _ in range(length)]
+        return tuple_node(path, elements)
+    if abi_type == "tuple":
+        prefix = path + "." if path else ""
+        return tuple_node(path, [build(field, prefix + field["name"])
+                                 for field in param["components"]])
+    if abi_type in ("bytes", "string"):
+        return Node("ABI_BYTES", path, True)
+    return Node("ABI_WORD", path, False)
+
+
+def tuple_node(path, fields) -> Node:
+    node = Node("ABI_TUPLE", path, any(field.dynamic for field in fields))
+    head = 0
+    for field in fields:
+        field.head = head
+        head += 1 if field.dynamic else field.size
+    node.size = head
+    node.words = sum(1 + field.words if field.dynamic else field.words for field in fields)
+    node.children = fields
+    return node
+
+
+def walk(node):
+    yield node
+    for child in node.children:
+        yield from walk(child)
+
+
+def depth(node) -> int:
+    """Number of parser frames needed to parse a node"""
+    if node.kind in ("ABI_WORD",):
+        return 0
+    return 1 + max((depth(child) for child in node.children), default=0)
+
+
+def layout(root):
+    """What the tables of a node tree hold, whatever the names of the parameters"""
+    return [(node.kind, node.dynamic, node.field, node.head, node.words, len(node.children))
+            for node in walk(root)]
+
+
+def load_function(contract, name):
+    abi = json.loads((ABIS / f"{contract}.abi.json").read_text())
+    for entry in abi:
+        if entry.get("type") == "function" and entry["name"] == name:
+            return entry
+    sys.exit(f"{name} not found in the ABI of {contract}")
+
+
+def load_selectors():
+    """Selectors declared in SELECTORS_LIST, which must be sorted by value"""
+    selectors = [(name, int(value, 16)) for name, value in
+                 re.findall(r"X\((\w+),\s*(0x[0-9a-fA-F]+),", PLUGIN_H.read_text())]
+    values = [value for _, value in selectors]
+    if values != sorted(set(values)):
+        sys.exit("SELECTORS_LIST must be sorted by selector value, without duplicates")
+    return dict(selectors)
+
+
+def main():
+    selectors = load_selectors()
+    nodes = []
+    roots = []
+    layouts = {}
+    max_depth = 0
+    for contract, name, selector_name, captured in FUNCTIONS:
+        function = load_function(contract, name)
+        signature = f"{name}({','.join(canonical_type(p) for p in function['inputs'])})"
+        selector = int.from_bytes(keccak256(signature.encode())[:4], "big")
+        if selectors.get(selector_name) != selector:
+            sys.exit(f"{selector_name} should be 0x{selector:08x} in SELECTORS_LIST ({signature})")
+
+        root = build({"type": "tuple", "components": function["inputs"]}, "")
+        tree = list(walk(root))
+        paths = {node.path: node for node in tree}
+        for path, field in captured.items():
+            if path not in paths:
+                sys.exit(f"{name}: unknown parameter {path}")
+            if paths[path].kind not in ("ABI_WORD", "ABI_ARRAY"):
+                sys.exit(f"{name}: only words and arrays lengths can be captured ({path})")
+            paths[path].field = field
+        if selector_name in layouts:
+            if layouts[selector_name] != layout(root):
+                sys.exit(f"{name}: the ABIs of {selector_name} do not give the same tables")
+            continue
+        layouts[selector_name] = layout(root)
+        for node in tree:
+            node.index = len(nodes)
+            nodes.append(node)
+        roots.append((selector_name, selector, signature, root.index))
+        max_depth = max(max_depth, depth(root))
+
+    if len(nodes) >= NO_NODE:
+        sys.exit("Too many nodes for 8-bit indexes")
+    if any(node.words > 0xFF for node in nodes):
+        sys.exit("Too many parameters in a tuple for 8-bit sizes")
+
+    signatures = {root: (selector, signature) for _, selector, signature, root in roots}
+    lines = []
+    for node in nodes:
+        if node.index in signatures:
+            selector, signature = signatures[node.index]
+            lines.append(f"    // 0x{selector:08x} {signature.split('(')[0]}")
+        children = node.children
+        child = children[0].index if children else NO_NODE
+        lines.append(f"    // {node.index}: {node.path or 'parameters'}")
+        lines.append(f"    {{{node.kind}, {'ABI_DYNAMIC' if node.dynamic else 0}, {node.field}, "
+                     f"{fmt(child)}, {fmt(node_next(node, nodes))}, {node.head}, {node.words}}},")
+
+    OUTPUT_H.write_text(f"""\
+// Generated by tools/generate_parser_tables.py from tests/abis, do not edit.
+
+#pragma once
+
+// Maximum number of nested tuples and arrays
+#define PARSER_MAX_DEPTH {max_depth}
+
+#define PARSER_NODES_COUNT {len(nodes)}
+""")
+
+    roots_lines = "\n".join(f"    [{name}] = {root}," for name, _, _, root in roots)
+    OUTPUT_C.write_text(f"""\
+// Generated by tools/generate_parser_tables.py from tests/abis, do not edit.
+
+#include "plugin.h"
+
+// {{kind, flags, field, child, next, head, words}}
+const abi_node_t PARSER_NODES[PARSER_NODES_COUNT] = {{
+{chr(10).join(lines)}
+}};
+
+const uint8_t PARSER_ROOTS[SELECTOR_COUNT] = {{
+{roots_lines}
+}};
+""")
+
+
+def fmt(index):
+    return "PARSER_NO_NODE" if index == NO_NODE else str(index)
+
+
+def node_next(node, nodes):
+    """Index of the next field of the tuple holding `node`"""
+    for parent in nodes:
+        if parent.kind == "ABI_TUPLE" and node in parent.children:
+            position = parent.children.index(node)
+            if position + 1 < len(parent.children):
+                return parent.children[position + 1].index
+    return NO_NODE
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""
+Generate the strategy registries of the plugin from tools/registry.json.
+
+The file holds one registry per chain, selected by the plugin from the chain id of the
+transaction. Each entry holds the ticker of a strategy, its address and the address of its
+underlying token. The strategies are sorted by binary address so the plugin finds them with a
+binary search, the registry index of a strategy being its rank in this order. The tokens get their own table, sorted
+by address as well, mapping each token to the index of its strategy. The C compiler checks both
+tables are sorted, so a hand edit of the generated file can not silently break the lookups.
+
+Transactions of other chains use an empty registry, all their strategies being unknown.
+"""
+
+import json
+import re
+import sys
+from pathlib import Path
+
+ROOT = Path(__file__).resolve().parent.parent
+REGISTRY = ROOT / "tools" / "registry.json"
+OUTPUT_C = ROOT / "src" / "registry_tables.c"
+OUTPUT_H = ROOT / "src" / "registry_tables.h"
+
+# Registry indexes are 8-bit, from 0xFE they are reserved: STRATEGIES_RUN and WITHDRAWAL_MARKER
+# (0xFE) then UNKNOWN_STRATEGY (0xFF) in src/plugin.h, whose static asserts check the same bound
+FIRST_RESERVED_INDEX = 0xFE
+# Tickers are stored in MAX_TICKER_LEN bytes, terminating null included
+MAX_TICKER_LENGTH = 11
+
+ADDRESS = re.compile(r"^0x[0-9a-fA-F]{40}$")
+
+
+def address(entry, key) -> bytes:
+    value = entry.get(key, "")
+    if not ADDRESS.match(value):
+        sys.exit(f"{entry.get('ticker')}: invalid {key} address {value!r}")
+    return bytes.fromhex(value[2:])
+
+
+def load_strategies(chain, entries):
+    strategies = []
+    for entry in entries:
+        ticker = entry.get("ticker", "")
+        if not ticker or len(ticker) > MAX_TICKER_LENGTH or not ticker.isascii():
+            sys.exit(f"{chain}: invalid ticker {ticker!r}")
+        strategies.append((address(entry, "strategy"), address(entry, "token"), entry))
+    if not strategies or len(strategies) > FIRST_RESERVED_INDEX:
+        sys.exit(f"{chain}: {len(strategies)} strategies, a registry holds 1 to "
+                 f"{FIRST_RESERVED_INDEX} strategies, indexed 0 to {FIRST_RESERVED_INDEX - 1:#x}")
+    for column, name in ((0, "strategy"), (1, "token")):
+        if len({strategy[column] for strategy in strategies}) != len(strategies):
+            sys.exit(f"{chain}: duplicate {name} address")
+    return sorted(strategies)
+
+
+def load():
+    registries = []
+    for chain, registry in json.loads(REGISTRY.read_text()).items():
+        if not re.match(r"^[a-z][a-z0-9_]*$", chain):
+            sys.exit(f"invalid chain name {chain!r}")
+        chain_id = registry.get("chain_id")
+        if not isinstance(chain_id, int) or not 0 < chain_id < 2**64:
+            sys.exit(f"{chain}: invalid chain id {chain_id!r}")
+        registries.append((chain, chain_id, load_strategies(chain, registry["strategies"])))
+    if len({chain_id for _, chain_id, _ in registries}) != len(registries):
+        sys.exit("Duplicate chain id")
+    return registries
+
+
+def key(value: bytes) -> str:
+    """Address as big endian 64, 64 and 32-bit integers, which the compiler can compare"""
+    return ", ".join(f"0x{value[start:end].hex()}ULL"
+                     for start, end in ((0, 8), (8, 16), (16, 20)))
+
+
+def ordering_checks(names, table) -> str:
+    return "\n".join(f"_Static_assert(ADDRESS_BEFORE({first}, {second}),\n"
+                     f"               \"{table} must be sorted by address\");"
+                     for first, second in zip(names, names[1:]))
+
+
+def registry_tables(chain, strategies):
+    """Tables of the registry of a chain, and their ordering checks"""
+    prefix = chain.upper()
+    tokens = sorted((token, index, entry)
+                    for index, (_, token, entry) in enumerate(strategies))
+
+    keys = []
+    strategy_lines = []
+    ticker_lines = []
+    for index, (strategy, _, entry) in enumerate(strategies):
+        keys.append(f"// {index}: {entry['ticker']} {entry['strategy']}")
+        keys.append(f"#define {prefix}_STRATEGY_{index} {key(strategy)}")
+        strategy_lines.append(f"    {{ADDRESS_BYTES({prefix}_STRATEGY_{index})}},")
+        ticker_lines.append(f"    \"{entry['ticker']}\",")
+    token_lines = []
+    token_strategies = []
+    for rank, (token, index, entry) in enumerate(tokens):
+        keys.append(f"// {entry['ticker']} token {entry['token']}")
+        keys.append(f"#define {prefix}_TOKEN_{rank} {key(token)}")
+        token_lines.append(f"    {{ADDRESS_BYTES({prefix}_TOKEN_{rank})}},")
+        token_strategies.append(str(index))
+
+    count = len(strategies)
+    strategies_names = [f"{prefix}_STRATEGY_{index}" for index in range(count)]
+    tokens_names = [f"{prefix}_TOKEN_{rank}" for rank in range(count)]
+    return f"""\
+{chr(10).join(keys)}
+
+// Strategies sorted by address, the registry index of a strategy is its rank
+static const uint8_t {chain}_strategy_addresses[{count}][ADDRESS_LENGTH] = {{
+{chr(10).join(strategy_lines)}
+}};
+
+static const char {chain}_tickers[{count}][MAX_TICKER_LEN] = {{
+{chr(10).join(ticker_lines)}
+}};
+
+// Underlying tokens sorted by address
+static const uint8_t {chain}_token_addresses[{count}][ADDRESS_LENGTH] = {{
+{chr(10).join(token_lines)}
+}};
+
+// Registry index of the strategy of each token
+static const uint8_t {chain}_token_strategies[{count}] = {{{", ".join(token_strategies)}}};
+
+{ordering_checks(strategies_names, f"{chain}_strategy_addresses")}
+
+{ordering_checks(tokens_names, f"{chain}_token_addresses")}
+"""
+
+
+def main():
+    registries = load()
+
+    OUTPUT_H.write_text(f"""\
+// Generated by tools/generate_registry.py from tools/registry.json, do not edit.
+
+#pragma once
+
+// Number of chains with a registry
+#define REGISTRIES_COUNT {len(registries)}
+
+// Size of the biggest registry
+#define STRATEGIES_MAX_COUNT {max(len(strategies) for _, _, strategies in registries)}
+""")
+
+    tables = "\n".join(f"// {chain}, chain id {chain_id}\n\n{registry_tables(chain, strategies)}"
+                       for chain, chain_id, strategies in registries)
+    entries = "\n".join(f"    {{{chain_id},\n"
+                         f"     {chain}_strategy_addresses,\n"
+                         f"     {chain}_tickers,\n"
+                         f"     {chain}_token_addresses,\n"
+                         f"     {chain}_token_strategies,\n"
+                         f"     {len(strategies)}}},"
+                         for chain, chain_id, strategies in registries)
+    OUTPUT_C.write_text(f"""\
+// Generated by tools/generate_registry.py from tools/registry.json, do not edit.
+
+#include "plugin.h"
+
+// Addresses are written as big endian (64, 64, 32)-bit integers, so that the compiler can check
+// the order of the tables the lookups binary search.
+#define ADDRESS_BYTES(...) ADDRESS_BYTES_(__VA_ARGS__)
+#define ADDRESS_BYTES_(a0, a1, a2) BYTES64(a0), BYTES64(a1), BYTES32(a2)
+#define BYTES64(v)                 BYTES32((v) >> 32), BYTES32(v)
+#define BYTES32(v) \\
+    (uint8_t) ((v) >> 24), (uint8_t) ((v) >> 16), (uint8_t) ((v) >> 8), (uint8_t) (v)
+#define ADDRESS_BEFORE(...) ADDRESS_BEFORE_(__VA_ARGS__)
+#define ADDRESS_BEFORE_(a0, a1, a2, b0, b1, b2) \\
+    ((a0) < (b0) || ((a0) == (b0) && ((a1) < (b1) || ((a1) == (b1) && (a2) < (b2)))))
+
+{tables}
+// {{chain_id, strategy_addresses, tickers, token_addresses, token_strategies, count}}
+const registry_t REGISTRIES[REGISTRIES_COUNT + 1] = {{
+{entries}
+    // other chains
+    {{0, NULL, NULL, NULL, NULL, 0}},
+}};
+""")
+
+
+if __name__ == "__main__":
+    main()
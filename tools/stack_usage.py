@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+"""
+Report the worst-case stack depth of the plugin entry points.
+
+The sources must be compiled with GCC `-fstack-usage -fcallgraph-info=su`, which writes one `.ci`
+call graph per translation unit, holding the stack frame of every function defined in it and its
+calls (see `make stack-usage`). The graphs are merged, and the deepest call chain of every entry
+point is computed. Functions without a frame in any graph (syscalls, compiler builtins, ...) are
+reported and counted as `--extern` says, 0 bytes by default.
+
+Exits with an error when an entry point exceeds the budget, or when its depth cannot be bounded
+(recursion, dynamic stack allocation).
+"""
+
+import argparse
+import re
+import sys
+from pathlib import Path
+
+NODE = re.compile(r'node: \{ title: "([^"]+)" label: "[^"\\]*(?:\\n[^"\\]*)*?'
+                  r'(?:\\n(\d+) bytes \((static|dynamic|dynamic,bounded|bounded)\))?"')
+EDGE = re.compile(r'edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+
+INDIRECT_CALL = "__indirect_call"
+
+
+class Graph:
+    def __init__(self):
+        self.frames = {}  # function -> (bytes, qualifier)
+        self.calls = {}  # function -> set of callees
+
+    def load(self, path: Path):
+        text = path.read_text()
+        for name, size, qualifier in NODE.findall(text):
+            self.calls.setdefault(name, set())
+            if size:
+                # static functions of different units may share a name, keep the biggest
+                previous = self.frames.get(name, (0, ""))[0]
+                if int(size) >= previous:
+                    self.frames[name] = (int(size), qualifier)
+        for source, target in EDGE.findall(text):
+            self.calls.setdefault(source, set()).add(target)
+            self.calls.setdefault(target, set())
+
+
+class Analysis:
+    def __init__(self, graph: Graph, externs: dict):
+        self.graph = graph
+        self.externs = externs
+        self.depths = {}  # function -> (bytes, deepest call chain)
+        self.unknown = set()
+        self.errors = []
+        self.stack = []
+
+    def depth(self, name):
+        if name in self.depths:
+            return self.depths[name]
+        if name in self.stack:
+            cycle = self.stack[self.stack.index(name):] + [name]
+            self.errors.append(f"recursion: {' > '.join(map(display, cycle))}")
+            return 0, [name]
+
+        if name in self.graph.frames:
+            size, qualifier = self.graph.frames[name]
+            if qualifier == "dynamic":
+                self.errors.append(f"{display(name)}: unbounded dynamic stack allocation")
+        elif name == INDIRECT_CALL:
+            self.errors.append("indirect call, the callee can not be known: "
+                               + " > ".join(map(display, self.stack)))
+            size = 0
+        else:
+            if name not in self.externs:
+                self.unknown.add(name)
+            size = self.externs.get(name, self.externs.get("*", 0))
+
+        self.stack.append(name)
+        deepest = (0, [])
+        for callee in sorted(self.graph.calls.get(name, ())):
+            deepest = max(deepest, self.depth(callee), key=lambda depth: depth[0])
+        self.stack.pop()
+
+        self.depths[name] = (size + deepest[0], [name] + deepest[1])
+        return self.depths[name]
+
+
+def display(name: str) -> str:
+    """Static functions are named after their file, keep only its base name"""
+    return name.rpartition("/")[2]
+
+
+def parse_extern(value: str):
+    name, _, size = value.partition("=")
+    if not size.isdigit():
+        raise argparse.ArgumentTypeError(f"expected NAME=BYTES, got {value}")
+    return name, int(size)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("graphs", type=Path, nargs="+", help=".ci files written by GCC")
+    parser.add_argument("--budget", type=int, default=1024,
+                        help="maximum stack depth of an entry point, in bytes")
+    parser.add_argument("--entry", default=r"^handle_", help="regex of the entry points names")
+    parser.add_argument("--extern", type=parse_extern, action="append", default=[],
+                        help="stack used by a function not compiled here, NAME=BYTES "
+                             "(* for every such function)")
+    args = parser.parse_args()
+
+    graph = Graph()
+    for path in args.graphs:
+        graph.load(path)
+    analysis = Analysis(graph, dict(args.extern))
+
+    entries = sorted(name for name in graph.frames if re.search(args.entry, name))
+    if not entries:
+        sys.exit(f"No entry point matching {args.entry}")
+
+    over_budget = False
+    print(f"{'entry point':<32} {'bytes':>6}  deepest call chain")
+    for entry in entries:
+        size, chain = analysis.depth(entry)
+        marker = ""
+        if size > args.budget:
+            over_budget = True
+            marker = "  OVER BUDGET"
+        print(f"{entry:<32} {size:>6}  {' > '.join(map(display, chain))}{marker}")
+
+    if analysis.unknown:
+        print(f"\nNot compiled, counted as {analysis.externs.get('*', 0)} bytes: "
+              + ", ".join(sorted(analysis.unknown)))
+    for error in dict.fromkeys(analysis.errors):
+        print(f"error: {error}", file=sys.stderr)
+    if over_budget:
+        print(f"error: stack budget of {args.budget} bytes exceeded", file=sys.stderr)
+    if over_budget or analysis.errors:
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()